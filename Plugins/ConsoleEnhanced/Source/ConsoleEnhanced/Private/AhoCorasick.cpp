@@ -0,0 +1,123 @@
+// Copyright Michael Galetzka, 2017
+
+#include "AhoCorasick.h"
+
+namespace AhoCorasickDefs
+{
+    // Limits the ASCII transition table to 4 MB, larger automatons use the hash lookups only. The states also have to stay below OutputFlag.
+    static const int32 MaxAsciiTransitions = 1 << 20;
+}
+
+FAhoCorasick::FAhoCorasick()
+{
+    Reset();
+}
+
+void FAhoCorasick::Reset()
+{
+    Nodes.Reset();
+    Nodes.AddDefaulted();
+    Edges.Reset();
+    AsciiTransitions.Reset();
+    PatternLengths.Reset();
+    bIsBuilt = true;
+}
+
+int32 FAhoCorasick::AddPattern(const FString& Pattern)
+{
+    check(!Pattern.IsEmpty());
+    bIsBuilt = false;
+
+    int32 State = 0;
+    for (TCHAR Char : Pattern)
+    {
+        const uint64 Key = MakeEdgeKey(State, FChar::ToLower(Char));
+        if (const int32* Next = Edges.Find(Key))
+        {
+            State = *Next;
+            continue;
+        }
+
+        const int32 NewState = Nodes.AddDefaulted();
+        Nodes[NewState].NextSibling = Nodes[State].FirstChild;
+        Nodes[State].FirstChild = NewState;
+        Edges.Add(Key, NewState);
+        State = NewState;
+    }
+
+    if (Nodes[State].Pattern == INDEX_NONE)
+    {
+        Nodes[State].Pattern = PatternLengths.Add(Pattern.Len());
+    }
+    return Nodes[State].Pattern;
+}
+
+void FAhoCorasick::Build()
+{
+    // The character of each node is only stored in the edge keys, so collect it once for the breadth-first pass
+    TArray<TCHAR> NodeChars;
+    NodeChars.SetNumZeroed(Nodes.Num());
+    for (const TPair<uint64, int32>& Edge : Edges)
+    {
+        NodeChars[Edge.Value] = (TCHAR)(Edge.Key & 0xFFFFFFFF);
+    }
+
+    // Breadth-first, so the failure target of every node is complete before its children are processed
+    TArray<int32> Queue;
+    Queue.Reserve(Nodes.Num());
+    for (int32 Child = Nodes[0].FirstChild; Child != INDEX_NONE; Child = Nodes[Child].NextSibling)
+    {
+        Nodes[Child].Fail = 0;
+        Nodes[Child].OutputLink = INDEX_NONE;
+        Queue.Add(Child);
+    }
+
+    for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); QueueIndex++)
+    {
+        const int32 State = Queue[QueueIndex];
+        for (int32 Child = Nodes[State].FirstChild; Child != INDEX_NONE; Child = Nodes[Child].NextSibling)
+        {
+            const int32 Fail = GetNextState(Nodes[State].Fail, NodeChars[Child]);
+            Nodes[Child].Fail = Fail;
+            Nodes[Child].OutputLink = Nodes[Fail].Pattern != INDEX_NONE ? Fail : Nodes[Fail].OutputLink;
+            Queue.Add(Child);
+        }
+    }
+
+    AsciiTransitions.Reset();
+    if (Nodes.Num() <= AhoCorasickDefs::MaxAsciiTransitions / NumAsciiChars)
+    {
+        // In breadth-first order the row of the failure target is always complete, so missing edges can be copied from it
+        AsciiTransitions.SetNumUninitialized(Nodes.Num() * NumAsciiChars);
+        for (int32 QueueIndex = -1; QueueIndex < Queue.Num(); QueueIndex++)
+        {
+            const int32 State = QueueIndex < 0 ? 0 : Queue[QueueIndex];
+            for (int32 Char = 0; Char < NumAsciiChars; Char++)
+            {
+                const int32* Next = Edges.Find(MakeEdgeKey(State, FChar::ToLower((TCHAR)Char)));
+                if (Next)
+                {
+                    const bool bHasOutput = Nodes[*Next].Pattern != INDEX_NONE || Nodes[*Next].OutputLink != INDEX_NONE;
+                    AsciiTransitions[State * NumAsciiChars + Char] = (*Next * NumAsciiChars) | (bHasOutput ? OutputFlag : 0);
+                }
+                else
+                {
+                    AsciiTransitions[State * NumAsciiChars + Char] = State == 0 ? 0 : AsciiTransitions[Nodes[State].Fail * NumAsciiChars + Char];
+                }
+            }
+        }
+    }
+
+    bIsBuilt = true;
+}
+
+bool FAhoCorasick::ContainsAny(const TCHAR* Text, int32 TextLen) const
+{
+    bool bFound = false;
+    FindAll(Text, TextLen, [&bFound](int32, int32, int32)
+    {
+        bFound = true;
+        return false;
+    });
+    return bFound;
+}
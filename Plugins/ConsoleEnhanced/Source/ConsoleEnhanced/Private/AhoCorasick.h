@@ -0,0 +1,160 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Aho-Corasick automaton to find all occurrences of a set of literal patterns in a text with a single pass.
+ * The time to search a text depends on the length of the text and the number of matches, not on the number of patterns.
+ *
+ * Patterns are matched case-insensitive. Add all patterns, call Build() and then search as often as needed.
+ * For small automatons Build() also computes a table with the next state for every ASCII character, so most characters
+ * of a text cost a single array lookup instead of a hash lookup per failure link.
+ */
+class FAhoCorasick
+{
+public:
+    FAhoCorasick();
+
+    /** Removes all patterns */
+    void Reset();
+
+    /**
+     * Adds a pattern to the automaton, Build() has to be called before searching again
+     *
+     * @return Index of the pattern, adding the same pattern twice returns the index of the first one
+     */
+    int32 AddPattern(const FString& Pattern);
+
+    /** Computes the failure links, has to be called after adding patterns */
+    void Build();
+
+    /** Number of distinct patterns in the automaton */
+    int32 NumPatterns() const { return PatternLengths.Num(); }
+
+    /**
+     * Calls OnMatch(PatternIndex, MatchBegin, MatchEnd) for every occurrence of a pattern in the text, ordered by MatchEnd.
+     * The search stops early if OnMatch returns false.
+     */
+    template<typename FunctorType>
+    void FindAll(const TCHAR* Text, int32 TextLen, FunctorType&& OnMatch) const
+    {
+        checkSlow(bIsBuilt);
+        if (AsciiTransitions.Num() == 0)
+        {
+            int32 State = 0;
+            for (int32 i = 0; i < TextLen; i++)
+            {
+                State = GetNextState(State, FChar::ToLower(Text[i]));
+                if (!ReportMatches(State, i + 1, OnMatch))
+                {
+                    return;
+                }
+            }
+            return;
+        }
+
+        // The transitions store the offset of the row of the next state, like the DFA of FLogRegex
+        const int32* Transitions = AsciiTransitions.GetData();
+        int32 Row = 0;
+        for (int32 i = 0; i < TextLen; i++)
+        {
+            const TCHAR Char = Text[i];
+            if ((uint32)Char < NumAsciiChars)
+            {
+                const int32 Transition = Transitions[Row + Char];
+                Row = Transition & ~OutputFlag;
+                if ((Transition & OutputFlag) == 0)
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                Row = GetNextState(Row / NumAsciiChars, FChar::ToLower(Char)) * NumAsciiChars;
+            }
+
+            if (!ReportMatches(Row / NumAsciiChars, i + 1, OnMatch))
+            {
+                return;
+            }
+        }
+    }
+
+    /** Returns true if any of the patterns occurs in the text */
+    bool ContainsAny(const TCHAR* Text, int32 TextLen) const;
+
+private:
+    struct FNode
+    {
+        /** Node the search continues with if there is no edge for the next character */
+        int32 Fail = 0;
+
+        /** Next node along the failure links that completes a pattern */
+        int32 OutputLink = INDEX_NONE;
+
+        /** Index of the pattern ending in this node */
+        int32 Pattern = INDEX_NONE;
+
+        /** Children of this node as singly linked list, only used to build the automaton */
+        int32 FirstChild = INDEX_NONE;
+        int32 NextSibling = INDEX_NONE;
+    };
+
+    /** Number of characters covered by the transition table */
+    static const int32 NumAsciiChars = 128;
+
+    /** Set in a transition if a pattern ends in the next state, so the nodes only have to be read for matches */
+    static const int32 OutputFlag = 1 << 30;
+
+    /** Calls OnMatch for all patterns ending in the given state, returns false if the search should stop */
+    template<typename FunctorType>
+    bool ReportMatches(int32 State, int32 MatchEnd, FunctorType& OnMatch) const
+    {
+        for (int32 Match = Nodes[State].Pattern != INDEX_NONE ? State : Nodes[State].OutputLink; Match != INDEX_NONE; Match = Nodes[Match].OutputLink)
+        {
+            const int32 PatternIndex = Nodes[Match].Pattern;
+            if (!OnMatch(PatternIndex, MatchEnd - PatternLengths[PatternIndex], MatchEnd))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static uint64 MakeEdgeKey(int32 State, TCHAR Char)
+    {
+        return ((uint64)State << 32) | (uint32)Char;
+    }
+
+    int32 GetNextState(int32 State, TCHAR Char) const
+    {
+        for (;;)
+        {
+            if (const int32* Next = Edges.Find(MakeEdgeKey(State, Char)))
+            {
+                return *Next;
+            }
+            if (State == 0)
+            {
+                return 0;
+            }
+            State = Nodes[State].Fail;
+        }
+    }
+
+    /** Node 0 is the root */
+    TArray<FNode> Nodes;
+
+    /** Goto function, maps (state, lower case character) to the next state */
+    TMap<uint64, int32> Edges;
+
+    /** Row offset of the next state (and OutputFlag) for every state and ASCII character with the failure links followed, empty if the automaton is too large */
+    TArray<int32> AsciiTransitions;
+
+    /** Length of every pattern, indexed by pattern index */
+    TArray<int32> PatternLengths;
+
+    bool bIsBuilt;
+};
@@ -0,0 +1,330 @@
+// Copyright Michael Galetzka, 2017
+
+#include "BlueprintLinkIndex.h"
+#include "AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "Editor.h"
+#include "UObject/UObjectIterator.h"
+
+namespace BlueprintLinkDefs
+{
+    // Paths appended since the automaton was built are searched one by one, appending more than this many rebuilds the automaton
+    static const int32 MaxUnmatchedBlueprints = 64;
+}
+
+FBlueprintLinkIndex::FBlueprintLinkIndex()
+    : NumMatchedBlueprints(0)
+    , bCheckStaleEntries(false)
+    , bIsDirty(true)
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.OnAssetAdded().AddRaw(this, &FBlueprintLinkIndex::OnAssetAdded);
+    AssetRegistry.OnAssetRemoved().AddRaw(this, &FBlueprintLinkIndex::OnAssetRemoved);
+    AssetRegistry.OnAssetRenamed().AddRaw(this, &FBlueprintLinkIndex::OnAssetRenamed);
+
+    FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FBlueprintLinkIndex::OnAssetLoaded);
+    FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FBlueprintLinkIndex::OnPostGarbageCollect);
+
+    if (GEditor)
+    {
+        // Compiling creates the generated class of new blueprints
+        GEditor->OnBlueprintCompiled().AddRaw(this, &FBlueprintLinkIndex::OnBlueprintCompiled);
+    }
+}
+
+FBlueprintLinkIndex::~FBlueprintLinkIndex()
+{
+    // The asset registry might already be gone at shutdown
+    FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry");
+    if (AssetRegistryModule)
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetAdded().RemoveAll(this);
+        AssetRegistry.OnAssetRemoved().RemoveAll(this);
+        AssetRegistry.OnAssetRenamed().RemoveAll(this);
+    }
+
+    FCoreUObjectDelegates::OnAssetLoaded.RemoveAll(this);
+    FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
+
+    if (GEditor)
+    {
+        GEditor->OnBlueprintCompiled().RemoveAll(this);
+    }
+}
+
+void FBlueprintLinkIndex::FindLinks(const FString& Line, TArray<FBlueprintLink>& OutLinks)
+{
+    if (bIsDirty)
+    {
+        Rebuild();
+    }
+    else
+    {
+        Update();
+    }
+    if (Blueprints.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FBlueprintLink, TInlineAllocator<4>> Candidates;
+    auto AddCandidate = [this, &Line, &Candidates](int32 EntryIndex, int32 MatchBegin, int32 MatchEnd)
+    {
+        UBlueprint* Blueprint = Blueprints[EntryIndex].Blueprint.Get();
+        if (!Blueprint)
+        {
+            return;
+        }
+
+        FBlueprintLink& Link = Candidates.AddDefaulted_GetRef();
+        Link.BeginIndex = MatchBegin;
+        Link.EndIndex = MatchEnd;
+        Link.Blueprint = Blueprint;
+
+        // A graph name can follow the path, e.g. "/Game/BP_Actor.BP_Actor_C:ReceiveBeginPlay". Only the graphs of this blueprint need to be checked.
+        if (MatchEnd < Line.Len() && Line[MatchEnd] == TEXT(':'))
+        {
+            const TCHAR* GraphStart = *Line + MatchEnd + 1;
+            const int32 RemainingLen = Line.Len() - MatchEnd - 1;
+
+            // Compiling can add, remove or rename graphs, so they are looked up for the matched blueprint instead of being indexed
+            TArray<UEdGraph*> AllGraphs;
+            Blueprint->GetAllGraphs(AllGraphs);
+            for (UEdGraph* Graph : AllGraphs)
+            {
+                if (!Graph)
+                {
+                    continue;
+                }
+
+                const FString GraphName = Graph->GetName();
+                const int32 NameLen = GraphName.Len();
+                const bool bIsLonger = MatchEnd + 1 + NameLen > Link.EndIndex;
+                if (bIsLonger && NameLen <= RemainingLen && FCString::Strnicmp(GraphStart, *GraphName, NameLen) == 0)
+                {
+                    Link.EndIndex = MatchEnd + 1 + NameLen;
+                    Link.Graph = Graph;
+                }
+            }
+        }
+    };
+
+    PathMatcher.FindAll(*Line, Line.Len(), [&AddCandidate](int32 PatternIndex, int32 MatchBegin, int32 MatchEnd)
+    {
+        AddCandidate(PatternIndex, MatchBegin, MatchEnd);
+        return true;
+    });
+
+    for (int32 EntryIndex = NumMatchedBlueprints; EntryIndex < Blueprints.Num(); EntryIndex++)
+    {
+        const FBlueprintEntry& Entry = Blueprints[EntryIndex];
+        if (!Entry.Blueprint.IsValid())
+        {
+            continue;
+        }
+
+        for (int32 MatchBegin = Line.Find(Entry.Path, ESearchCase::IgnoreCase); MatchBegin != INDEX_NONE;
+            MatchBegin = Line.Find(Entry.Path, ESearchCase::IgnoreCase, ESearchDir::FromStart, MatchBegin + 1))
+        {
+            AddCandidate(EntryIndex, MatchBegin, MatchBegin + Entry.Path.Len());
+        }
+    }
+
+    // Prefer the earliest and then the longest link where links overlap
+    Candidates.Sort([](const FBlueprintLink& A, const FBlueprintLink& B)
+    {
+        return A.BeginIndex != B.BeginIndex ? A.BeginIndex < B.BeginIndex : A.EndIndex > B.EndIndex;
+    });
+
+    int32 LastEnd = 0;
+    for (const FBlueprintLink& Link : Candidates)
+    {
+        if (Link.BeginIndex >= LastEnd)
+        {
+            OutLinks.Add(Link);
+            LastEnd = Link.EndIndex;
+        }
+    }
+}
+
+void FBlueprintLinkIndex::Rebuild()
+{
+    Blueprints.Reset();
+    PathIndices.Reset();
+    BlueprintIndices.Reset();
+    PendingBlueprints.Reset();
+    BlueprintsWithoutClass.Reset();
+
+    for (TObjectIterator<UBlueprint> Itr; Itr; ++Itr)
+    {
+        UBlueprint* Blueprint = *Itr;
+        if (Blueprint->GeneratedClass)
+        {
+            AddBlueprint(Blueprint);
+        }
+        else
+        {
+            BlueprintsWithoutClass.Add(Blueprint);
+        }
+    }
+
+    BuildPathMatcher();
+    bIsDirty = false;
+}
+
+void FBlueprintLinkIndex::BuildPathMatcher()
+{
+    TArray<FBlueprintEntry> OldEntries = MoveTemp(Blueprints);
+    Blueprints.Reset(OldEntries.Num());
+    PathIndices.Reset();
+    BlueprintIndices.Reset();
+    PathMatcher.Reset();
+
+    for (FBlueprintEntry& Entry : OldEntries)
+    {
+        UBlueprint* Blueprint = Entry.Blueprint.Get();
+        if (!Blueprint)
+        {
+            continue;
+        }
+
+        // Every path has only one entry, so the pattern index is the index of the entry
+        const int32 EntryIndex = Blueprints.Add(MoveTemp(Entry));
+        verify(PathMatcher.AddPattern(Blueprints[EntryIndex].Path) == EntryIndex);
+        PathIndices.Add(Blueprints[EntryIndex].Path, EntryIndex);
+        BlueprintIndices.Add(Blueprint, EntryIndex);
+    }
+
+    PathMatcher.Build();
+    NumMatchedBlueprints = Blueprints.Num();
+    bCheckStaleEntries = false;
+}
+
+void FBlueprintLinkIndex::Update()
+{
+    for (const TWeakObjectPtr<UBlueprint>& Pending : PendingBlueprints)
+    {
+        UBlueprint* Blueprint = Pending.Get();
+        if (!Blueprint)
+        {
+            continue;
+        }
+        if (!Blueprint->GeneratedClass)
+        {
+            BlueprintsWithoutClass.AddUnique(Blueprint);
+            continue;
+        }
+
+        // Loading and registry events often report the same blueprint more than once
+        const int32* EntryIndex = BlueprintIndices.Find(Blueprint);
+        if (EntryIndex && Blueprints[*EntryIndex].Path == Blueprint->GeneratedClass->GetPathName())
+        {
+            continue;
+        }
+
+        RemoveBlueprint(Blueprint);
+        AddBlueprint(Blueprint);
+    }
+    PendingBlueprints.Reset();
+
+    bool bNeedsBuild = Blueprints.Num() - NumMatchedBlueprints > BlueprintLinkDefs::MaxUnmatchedBlueprints;
+    if (bCheckStaleEntries && !bNeedsBuild)
+    {
+        bCheckStaleEntries = false;
+
+        // Stale entries only cost memory, so they are dropped once they make up half of the index
+        int32 NumStale = 0;
+        for (const FBlueprintEntry& Entry : Blueprints)
+        {
+            NumStale += Entry.Blueprint.IsValid() ? 0 : 1;
+        }
+        bNeedsBuild = NumStale > 0 && NumStale * 2 >= Blueprints.Num();
+    }
+
+    if (bNeedsBuild)
+    {
+        BuildPathMatcher();
+    }
+}
+
+void FBlueprintLinkIndex::AddBlueprint(UBlueprint* Blueprint)
+{
+    FString Path = Blueprint->GeneratedClass->GetPathName();
+    if (const int32* EntryIndex = PathIndices.Find(Path))
+    {
+        // The path belongs to a stale entry or to another blueprint, usually an old one waiting for garbage collection after a reload.
+        // The blueprint indexed last takes over the path.
+        FBlueprintEntry& Entry = Blueprints[*EntryIndex];
+        BlueprintIndices.Remove(Entry.Blueprint);
+        Entry.Blueprint = Blueprint;
+        BlueprintIndices.Add(Blueprint, *EntryIndex);
+        return;
+    }
+
+    const int32 EntryIndex = Blueprints.AddDefaulted();
+    Blueprints[EntryIndex].Blueprint = Blueprint;
+    Blueprints[EntryIndex].Path = Path;
+    PathIndices.Add(MoveTemp(Path), EntryIndex);
+    BlueprintIndices.Add(Blueprint, EntryIndex);
+}
+
+void FBlueprintLinkIndex::RemoveBlueprint(UBlueprint* Blueprint)
+{
+    int32 EntryIndex;
+    if (BlueprintIndices.RemoveAndCopyValue(Blueprint, EntryIndex))
+    {
+        Blueprints[EntryIndex].Blueprint.Reset();
+        bCheckStaleEntries = true;
+    }
+}
+
+void FBlueprintLinkIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+    // Only loaded blueprints are linked, so the many events during the initial asset scan can be ignored
+    if (AssetData.IsAssetLoaded())
+    {
+        if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false)))
+        {
+            PendingBlueprints.Add(Blueprint);
+        }
+    }
+}
+
+void FBlueprintLinkIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+    if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false)))
+    {
+        RemoveBlueprint(Blueprint);
+    }
+}
+
+void FBlueprintLinkIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    // The generated class is renamed with the blueprint, the next lookup moves the blueprint to its new path
+    if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false)))
+    {
+        PendingBlueprints.Add(Blueprint);
+    }
+}
+
+void FBlueprintLinkIndex::OnAssetLoaded(UObject* Asset)
+{
+    if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+    {
+        PendingBlueprints.Add(Blueprint);
+    }
+}
+
+void FBlueprintLinkIndex::OnBlueprintCompiled()
+{
+    PendingBlueprints.Append(BlueprintsWithoutClass);
+    BlueprintsWithoutClass.Reset();
+}
+
+void FBlueprintLinkIndex::OnPostGarbageCollect()
+{
+    // The lookup already skips the entries of collected blueprints, they only have to be dropped once there are many of them
+    bCheckStaleEntries = true;
+}
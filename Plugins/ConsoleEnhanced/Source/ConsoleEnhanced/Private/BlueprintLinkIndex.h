@@ -0,0 +1,105 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AhoCorasick.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class UEdGraph;
+struct FAssetData;
+
+/** A blueprint path found in a log line */
+struct FBlueprintLink
+{
+    /** Start of the link in the line */
+    int32 BeginIndex;
+
+    /** End of the link in the line, including the graph name if there is one */
+    int32 EndIndex;
+
+    TWeakObjectPtr<UBlueprint> Blueprint;
+
+    /** Graph following the blueprint path, invalid if the link only names the blueprint */
+    TWeakObjectPtr<UEdGraph> Graph;
+};
+
+/**
+ * Index of the generated class paths (e.g. "/Game/BP_Actor.BP_Actor_C") of all loaded blueprints.
+ * The paths are matched with a single automaton, so finding the links in a line does not depend on the number of loaded blueprints.
+ *
+ * The index is built once on first use and then updated from the asset events: loaded, added and renamed blueprints are queued and
+ * appended on the next lookup, which searches the few paths appended since the last build of the automaton one by one. The automaton
+ * is only rebuilt once enough paths were appended or removed, so loading many blueprints costs no rebuild per blueprint. Game thread only.
+ */
+class FBlueprintLinkIndex
+{
+public:
+    FBlueprintLinkIndex();
+    ~FBlueprintLinkIndex();
+
+    /** Finds all blueprint paths in the given line, the links are ordered by their position and do not overlap */
+    void FindLinks(const FString& Line, TArray<FBlueprintLink>& OutLinks);
+
+    /** Forces a rebuild of the index the next time it is used */
+    void MarkDirty() { bIsDirty = true; }
+
+private:
+    struct FBlueprintEntry
+    {
+        /** Invalid once the blueprint is deleted, renamed or garbage collected */
+        TWeakObjectPtr<UBlueprint> Blueprint;
+
+        /** Generated class path of the blueprint */
+        FString Path;
+    };
+
+    /** Collects all loaded blueprints and builds the automaton from their paths */
+    void Rebuild();
+
+    /** Drops the stale entries and builds the automaton from the paths of the remaining ones */
+    void BuildPathMatcher();
+
+    /** Indexes the queued blueprints, rebuilds the automaton if too many entries are missing from it or are stale */
+    void Update();
+
+    /** Adds an entry for the blueprint or takes over the entry with the same path */
+    void AddBlueprint(UBlueprint* Blueprint);
+
+    /** Invalidates the entry of the blueprint, the entry stays until the automaton is rebuilt */
+    void RemoveBlueprint(UBlueprint* Blueprint);
+
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    void OnAssetLoaded(UObject* Asset);
+    void OnBlueprintCompiled();
+    void OnPostGarbageCollect();
+
+    /** Matches the paths of the first NumMatchedBlueprints entries, the pattern index is the index of the entry */
+    FAhoCorasick PathMatcher;
+
+    /** All indexed paths, each path has only one entry */
+    TArray<FBlueprintEntry> Blueprints;
+
+    /** Number of entries in the automaton, the entries after them are searched one by one */
+    int32 NumMatchedBlueprints;
+
+    /** Entry index of every path */
+    TMap<FString, int32> PathIndices;
+
+    /** Entry index of every indexed blueprint */
+    TMap<TWeakObjectPtr<UBlueprint>, int32> BlueprintIndices;
+
+    /** Blueprints loaded, added or renamed since the last lookup */
+    TArray<TWeakObjectPtr<UBlueprint>> PendingBlueprints;
+
+    /** Loaded blueprints without a generated class, they are queued again after the next compile */
+    TArray<TWeakObjectPtr<UBlueprint>> BlueprintsWithoutClass;
+
+    /** Set when entries might have become stale, the next lookup counts them */
+    bool bCheckStaleEntries;
+
+    bool bIsDirty;
+};
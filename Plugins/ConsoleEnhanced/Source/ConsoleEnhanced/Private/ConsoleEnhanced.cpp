@@ -7,8 +7,11 @@
 #include "Editor/WorkspaceMenuStructure/Public/WorkspaceMenuStructureModule.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "LogDisplaySettings.h"
+#include "Classes/EditorStyleSettings.h"
 #include "ISettingsModule.h"
 #include "EditorStyleSet.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
 
 #define LOCTEXT_NAMESPACE "FConsoleEnhancedModule"
 
@@ -20,13 +23,19 @@ namespace OutputLogModule
     static const FName OutputLogTabName4 = FName(TEXT("OutputLogPlus4"));
 }
 
-/** This class is to capture all log output even if the log window is closed */
+/**
+ * This class is to capture all log output even if the log window is closed.
+ * Log lines can arrive on any thread, they are queued without locking and moved into the message store once per frame on the game thread.
+ */
 class FOutputLogHistory : public FOutputDevice
 {
 public:
 
     FOutputLogHistory()
+        : Messages(MakeShareable(new FLogMessageStore(GetDefault<ULogDisplaySettings>()->MaxHistoryLines, (int64)GetDefault<ULogDisplaySettings>()->MaxHistoryMemoryMB * 1024 * 1024)))
+        , LogTimestampMode(ELogTimes::None)
     {
+        TickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FOutputLogHistory::Tick));
         GLog->AddOutputDevice(this);
         GLog->SerializeBacklog(this);
     }
@@ -38,10 +47,16 @@ public:
         {
             GLog->RemoveOutputDevice(this);
         }
+        FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+        if (StyleSettingChangedHandle.IsValid() && UObjectInitialized() && !GExitPurge)
+        {
+            GetMutableDefault<UEditorStyleSettings>()->OnSettingChanged().Remove(StyleSettingChangedHandle);
+        }
     }
 
-    /** Gets all captured messages */
-    const TArray< TSharedPtr<FLogMessage> >& GetMessages() const
+    /** Gets the store with all captured messages, shared by all log windows */
+    TSharedRef<FLogMessageStore> GetMessages() const
     {
         return Messages;
     }
@@ -50,33 +65,114 @@ protected:
 
     virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category) override
     {
-        // Capture all incoming messages and store them in history
-        SOutputLog::CreateLogMessages(V, Verbosity, Category, -1, Messages);
+        Serialize(V, Verbosity, Category, -1);
     }
 
     virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time) override
     {
-        // Capture all incoming messages and store them in history
-        SOutputLog::CreateLogMessages(V, Verbosity, Category, Time, Messages);
-    }    
+        if (Verbosity == ELogVerbosity::SetColor)
+        {
+            return;
+        }
+
+        // Capture all incoming messages, they are processed and stored in the history on the next game thread tick.
+        // The time stamp is taken now, so messages keep their time even if the game thread is busy.
+        PendingLines.Enqueue(FPendingLogLine(V, Verbosity, Category, Time >= 0 ? Time : FPlatformTime::Seconds() - GStartTime));
+    }
+
+    virtual bool CanBeUsedOnAnyThread() const override
+    {
+        return true;
+    }
 
 private:
 
-    /** All log messages since this module has been started */
-    TArray< TSharedPtr<FLogMessage> > Messages;
+    /** Raw log line as received from any thread */
+    struct FPendingLogLine
+    {
+        FString Text;
+        ELogVerbosity::Type Verbosity;
+        FName Category;
+        double Time;
+
+        FPendingLogLine() {}
+
+        FPendingLogLine(const TCHAR* InText, ELogVerbosity::Type InVerbosity, const FName& InCategory, double InTime)
+            : Text(InText)
+            , Verbosity(InVerbosity)
+            , Category(InCategory)
+            , Time(InTime)
+        {
+        }
+    };
+
+    /** Moves all queued log lines into the message store in a single batch */
+    bool Tick(float DeltaTime)
+    {
+        // The module can start before the UObject system, the setting is read once it is up and then only when it changes
+        if (!StyleSettingChangedHandle.IsValid() && UObjectInitialized() && !GExitPurge)
+        {
+            UEditorStyleSettings* StyleSettings = GetMutableDefault<UEditorStyleSettings>();
+            LogTimestampMode = StyleSettings->LogTimestampMode;
+            StyleSettingChangedHandle = StyleSettings->OnSettingChanged().AddRaw(this, &FOutputLogHistory::OnStyleSettingChanged);
+        }
+
+        bool bAddedMessages = false;
+        FPendingLogLine Line;
+        while (PendingLines.Dequeue(Line))
+        {
+            bAddedMessages |= SOutputLog::CreateLogMessages(*Line.Text, Line.Verbosity, Line.Category, Line.Time, LogTimestampMode, *Messages);
+        }
+
+        if (bAddedMessages)
+        {
+            Messages->NotifyMessagesAdded();
+        }
+        return true;
+    }
+
+    void OnStyleSettingChanged(FName PropertyName)
+    {
+        LogTimestampMode = GetDefault<UEditorStyleSettings>()->LogTimestampMode;
+    }
+
+    /** Lock free queue that receives the log lines from all threads */
+    TQueue<FPendingLogLine, EQueueMode::Mpsc> PendingLines;
+
+    /** Handle to the game thread ticker draining the queue */
+    FDelegateHandle TickHandle;
+
+    /** The most recent log messages since this module has been started */
+    TSharedRef<FLogMessageStore> Messages;
+
+    /** How the time stamps in the message prefixes are formatted, from the editor style settings. Until they can be read, no time stamps like the editor default. */
+    ELogTimes::Type LogTimestampMode;
+
+    /** Handle to the registered OnSettingChanged delegate of the editor style settings */
+    FDelegateHandle StyleSettingChangedHandle;
 };
 
 /** Our global output log app spawner */
 static TSharedPtr<FOutputLogHistory> OutputLogHistory;
 
+/** Index of the loaded blueprints shared by all log windows, created with the first window because it needs the editor */
+static TSharedPtr<FBlueprintLinkIndex> BlueprintLinkIndex;
+
 TSharedRef<SDockTab> SpawnOutputLog(const FSpawnTabArgs& Args)
 {
+    if (!BlueprintLinkIndex.IsValid())
+    {
+        BlueprintLinkIndex = MakeShareable(new FBlueprintLinkIndex);
+    }
+
     return SNew(SDockTab)
         .Icon(FEditorStyle::GetBrush("Log.TabIcon"))
         .TabRole(ETabRole::NomadTab)
         .Label(NSLOCTEXT("OutputLogPlus", "TabTitle", "Enhanced Output Log"))
         [
-            SNew(SOutputLog).Messages(OutputLogHistory->GetMessages())
+            SNew(SOutputLog)
+            .MessageStore(OutputLogHistory->GetMessages())
+            .BlueprintLinks(BlueprintLinkIndex)
         ];
 }
 
@@ -126,6 +222,11 @@ void FConsoleEnhancedModule::ShutdownModule()
         FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(OutputLogModule::OutputLogTabName);
     }
 
+    BlueprintLinkIndex.Reset();
+
+    // Removes the history from GLog and the core ticker while both are still alive, the static pointer would only be released after them
+    OutputLogHistory.Reset();
+
     ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings");
     if (SettingsModule)
     {
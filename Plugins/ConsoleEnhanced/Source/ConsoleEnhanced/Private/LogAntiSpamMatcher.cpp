@@ -0,0 +1,234 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogAntiSpamMatcher.h"
+
+FLogAntiSpamMatcher::FLogAntiSpamMatcher(const FString& Pattern)
+    : NumLiteralAlternatives(0)
+{
+    TArray<FString> Alternatives;
+    if (!SplitAlternatives(Pattern, Alternatives))
+    {
+        Alternatives.Reset();
+        RegexPatterns.Add(Pattern);
+    }
+
+    // The automaton folds case, so patterns that only differ in case share a pattern index
+    auto AddPattern = [this](const FString& Literal) -> FPatternTargets&
+    {
+        const int32 PatternIndex = LiteralMatcher.AddPattern(Literal);
+        if (PatternIndex == PatternTargets.Num())
+        {
+            PatternTargets.AddDefaulted();
+        }
+        return PatternTargets[PatternIndex];
+    };
+
+    for (const FString& Alternative : Alternatives)
+    {
+        FString Literal;
+        if (UnescapeLiteral(Alternative, Literal))
+        {
+            AddPattern(Literal).Literals.AddUnique(Literal);
+            NumLiteralAlternatives++;
+        }
+        else
+        {
+            RegexPatterns.Add(Alternative);
+        }
+    }
+
+    for (const FString& RegexPattern : RegexPatterns)
+    {
+        const int32 RegexIndex = Regexes.Add(MakeUnique<FLogRegex>(RegexPattern));
+        const FLogRegex& Regex = *Regexes[RegexIndex];
+        if (!Regex.IsValid())
+        {
+            // Like the whole expression, an invalid expression does not match anything
+            LiteralMatcher.Reset();
+            PatternTargets.Reset();
+            Regexes.Reset();
+            UnconditionalRegexes.Reset();
+            NumLiteralAlternatives = 0;
+            return;
+        }
+
+        for (const FString& RequiredLiteral : Regex.GetRequiredLiterals())
+        {
+            AddPattern(RequiredLiteral).Regexes.AddUnique(RegexIndex);
+        }
+        if (Regex.GetRequiredLiterals().Num() == 0)
+        {
+            UnconditionalRegexes.Add(RegexIndex);
+        }
+    }
+    LiteralMatcher.Build();
+}
+
+bool FLogAntiSpamMatcher::IsMatch(const TCHAR* Text, int32 TextLen) const
+{
+    bool bFound = false;
+    TArray<int32, TInlineAllocator<8>> CandidateRegexes;
+    if (LiteralMatcher.NumPatterns() > 0)
+    {
+        LiteralMatcher.FindAll(Text, TextLen, [this, Text, &bFound, &CandidateRegexes](int32 PatternIndex, int32 MatchBegin, int32)
+        {
+            const FPatternTargets& Targets = PatternTargets[PatternIndex];
+            for (const FString& Literal : Targets.Literals)
+            {
+                // The expression is case sensitive
+                if (FMemory::Memcmp(Text + MatchBegin, *Literal, Literal.Len() * sizeof(TCHAR)) == 0)
+                {
+                    bFound = true;
+                    return false;
+                }
+            }
+            for (int32 RegexIndex : Targets.Regexes)
+            {
+                CandidateRegexes.AddUnique(RegexIndex);
+            }
+            return true;
+        });
+    }
+    if (bFound)
+    {
+        return true;
+    }
+
+    for (int32 RegexIndex : UnconditionalRegexes)
+    {
+        if (Regexes[RegexIndex]->IsMatch(Text, TextLen))
+        {
+            return true;
+        }
+    }
+    for (int32 RegexIndex : CandidateRegexes)
+    {
+        if (Regexes[RegexIndex]->IsMatch(Text, TextLen))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FLogAntiSpamMatcher::SplitAlternatives(const FString& Pattern, TArray<FString>& OutAlternatives)
+{
+    TArray<FString> Alternatives;
+    int32 Depth = 0;
+    bool bInClass = false;
+    int32 AlternativeStart = 0;
+    for (int32 i = 0; i < Pattern.Len(); i++)
+    {
+        const TCHAR Char = Pattern[i];
+        if (Char == TEXT('\\'))
+        {
+            if (++i >= Pattern.Len())
+            {
+                return false;
+            }
+        }
+        else if (bInClass)
+        {
+            bInClass = Char != TEXT(']');
+        }
+        else if (Char == TEXT('['))
+        {
+            bInClass = true;
+        }
+        else if (Char == TEXT('('))
+        {
+            Depth++;
+        }
+        else if (Char == TEXT(')') && --Depth < 0)
+        {
+            return false;
+        }
+        else if (Char == TEXT('|') && Depth == 0)
+        {
+            Alternatives.Add(Pattern.Mid(AlternativeStart, i - AlternativeStart));
+            AlternativeStart = i + 1;
+        }
+    }
+    if (Depth != 0 || bInClass)
+    {
+        return false;
+    }
+    Alternatives.Add(Pattern.Mid(AlternativeStart));
+
+    for (const FString& Alternative : Alternatives)
+    {
+        // "(A|B)" as a whole alternative is the same as two alternatives A and B
+        if (Alternative.StartsWith(TEXT("(")) && FindGroupEnd(Alternative, 0) == Alternative.Len() - 1)
+        {
+            FString Inner = Alternative.Mid(1, Alternative.Len() - 2);
+            if (Inner.StartsWith(TEXT("?:")))
+            {
+                Inner = Inner.Mid(2);
+            }
+            if (!Inner.StartsWith(TEXT("?")) && SplitAlternatives(Inner, OutAlternatives))
+            {
+                continue;
+            }
+        }
+        OutAlternatives.Add(Alternative);
+    }
+    return true;
+}
+
+int32 FLogAntiSpamMatcher::FindGroupEnd(const FString& Pattern, int32 Start)
+{
+    int32 Depth = 0;
+    bool bInClass = false;
+    for (int32 i = Start; i < Pattern.Len(); i++)
+    {
+        const TCHAR Char = Pattern[i];
+        if (Char == TEXT('\\'))
+        {
+            i++;
+        }
+        else if (bInClass)
+        {
+            bInClass = Char != TEXT(']');
+        }
+        else if (Char == TEXT('['))
+        {
+            bInClass = true;
+        }
+        else if (Char == TEXT('('))
+        {
+            Depth++;
+        }
+        else if (Char == TEXT(')') && --Depth == 0)
+        {
+            return i;
+        }
+    }
+    return INDEX_NONE;
+}
+
+bool FLogAntiSpamMatcher::UnescapeLiteral(const FString& Alternative, FString& OutLiteral)
+{
+    OutLiteral.Reset(Alternative.Len());
+    for (int32 i = 0; i < Alternative.Len(); i++)
+    {
+        const TCHAR Char = Alternative[i];
+        if (Char == TEXT('\\'))
+        {
+            // Escaped letters and digits are classes, assertions or control characters
+            if (i + 1 >= Alternative.Len() || FChar::IsAlnum(Alternative[i + 1]) || (uint32)Alternative[i + 1] > 0x7F)
+            {
+                return false;
+            }
+            OutLiteral.AppendChar(Alternative[++i]);
+        }
+        else if (FCString::Strchr(TEXT(".^$*+?()[]{}|"), Char) != nullptr)
+        {
+            return false;
+        }
+        else
+        {
+            OutLiteral.AppendChar(Char);
+        }
+    }
+    return !OutLiteral.IsEmpty();
+}
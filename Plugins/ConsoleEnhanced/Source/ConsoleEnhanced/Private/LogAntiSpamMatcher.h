@@ -0,0 +1,67 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AhoCorasick.h"
+#include "LogRegex.h"
+
+/**
+ * Matches the anti spam expression of the display settings, which is mostly a list of literal alternatives like "(PIE: )|(LogInit: )".
+ *
+ * The top level alternatives without any regex syntax are searched with a single automaton pass over the message. Only the remaining
+ * alternatives (e.g. "Deleted \d* Actors") are compiled as regular expressions. Their required literals are added to the same automaton,
+ * so they only run on messages that contain one of them, and adding more alternatives costs almost nothing per message.
+ * The result is the same as matching the whole expression case sensitive. A matcher is immutable, so it can be shared by copies of a filter.
+ */
+class FLogAntiSpamMatcher
+{
+public:
+    explicit FLogAntiSpamMatcher(const FString& Pattern);
+
+    /** Returns true if the expression matches anywhere in the text. An invalid expression never matches. */
+    bool IsMatch(const TCHAR* Text, int32 TextLen) const;
+
+    /** Number of alternatives that are searched as literals */
+    int32 NumLiterals() const { return NumLiteralAlternatives; }
+
+    /** Alternatives that need a regular expression */
+    const TArray<FString>& GetRegexPatterns() const { return RegexPatterns; }
+
+private:
+    /**
+     * Splits the pattern at the top level "|" and recursively unwraps alternatives that are a single group.
+     *
+     * @return false if the pattern is not well formed, it is matched as a whole then
+     */
+    static bool SplitAlternatives(const FString& Pattern, TArray<FString>& OutAlternatives);
+
+    /** Returns the index of the parenthesis closing the group that opens at Start, or INDEX_NONE */
+    static int32 FindGroupEnd(const FString& Pattern, int32 Start);
+
+    /** Removes the escapes of a literal alternative, returns false if it contains any other regex syntax */
+    static bool UnescapeLiteral(const FString& Alternative, FString& OutLiteral);
+
+    /** What a match of a pattern of the automaton means */
+    struct FPatternTargets
+    {
+        /** Literal alternatives with their original case, the automaton folds case */
+        TArray<FString> Literals;
+
+        /** Regular expressions that require the pattern */
+        TArray<int32> Regexes;
+    };
+
+    /** Matches the literal alternatives and the required literals of the regular expressions case insensitive */
+    FAhoCorasick LiteralMatcher;
+
+    /** Indexed by the pattern index of the automaton */
+    TArray<FPatternTargets> PatternTargets;
+    int32 NumLiteralAlternatives;
+
+    TArray<FString> RegexPatterns;
+    TArray<TUniquePtr<FLogRegex>> Regexes;
+
+    /** Regular expressions without required literals, they are tested on every text */
+    TArray<int32> UnconditionalRegexes;
+};
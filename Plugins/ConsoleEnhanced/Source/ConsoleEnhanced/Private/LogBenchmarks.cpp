@@ -0,0 +1,200 @@
+// Copyright Michael Galetzka, 2017
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "LogDisplaySettings.h"
+#include "LogRegex.h"
+#include "LogAntiSpamMatcher.h"
+#include "LogLiteralSearch.h"
+#include "LogLinkScanner.h"
+#include "Internationalization/Regex.h"
+#include "Misc/TextFilterUtils.h"
+#include <regex>
+#include <string>
+
+DEFINE_LOG_CATEGORY_STATIC(LogOutputLogBenchmark, Log, All);
+
+namespace LogBenchmarks
+{
+    /** Runs the filter over all lines and logs how long it took and how many lines matched */
+    template<typename FunctorType>
+    static void Measure(const TCHAR* Name, int32 NumLines, FunctorType&& IsMatch)
+    {
+        int32 NumMatches = 0;
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 i = 0; i < NumLines; i++)
+        {
+            NumMatches += IsMatch(i) ? 1 : 0;
+        }
+        const double Duration = FPlatformTime::Seconds() - StartTime;
+        UE_LOG(LogOutputLogBenchmark, Display, TEXT("%-24s %10.2f ms %10.1f ns/line %8d matches"), Name, Duration * 1000.0, Duration * 1.0e9 / FMath::Max(NumLines, 1), NumMatches);
+    }
+
+    /** Compares FLogRegex with the std::regex the filters used before on the lines of a log file */
+    static void CompareRegex(const FString& Pattern, bool bIgnoreCase, const TArray<FString>& Lines, const TArray<std::string>& Utf8Lines)
+    {
+        UE_LOG(LogOutputLogBenchmark, Display, TEXT("Pattern (%s): %s"), bIgnoreCase ? TEXT("ignore case") : TEXT("match case"), *Pattern);
+
+        const double CompileStartTime = FPlatformTime::Seconds();
+        const FLogRegex Regex(Pattern, bIgnoreCase ? ELogRegexFlags::IgnoreCase : ELogRegexFlags::None);
+        const double CompileDuration = FPlatformTime::Seconds() - CompileStartTime;
+        if (!Regex.IsValid())
+        {
+            UE_LOG(LogOutputLogBenchmark, Warning, TEXT("FLogRegex can not compile the pattern: %s"), *Regex.GetError());
+            return;
+        }
+        UE_LOG(LogOutputLogBenchmark, Display, TEXT("FLogRegex compiled in %.2f ms using %s"), CompileDuration * 1000.0, Regex.HasDfa() ? TEXT("a DFA") : TEXT("NFA simulation"));
+        UE_LOG(LogOutputLogBenchmark, Display, TEXT("Required literals: %s"), Regex.GetRequiredLiterals().Num() > 0 ? *FString::Join(Regex.GetRequiredLiterals(), TEXT(", ")) : TEXT("none"));
+        Measure(TEXT("FLogRegex"), Lines.Num(), [&Regex, &Lines](int32 i) { return Regex.IsMatch(Lines[i]); });
+
+        try {
+            auto flags = std::regex_constants::nosubs | std::regex_constants::optimize;
+            if (bIgnoreCase) {
+                flags |= std::regex_constants::icase;
+            }
+            const std::regex StdRegex(TCHAR_TO_UTF8(*Pattern), flags);
+            Measure(TEXT("std::regex"), Utf8Lines.Num(), [&StdRegex, &Utf8Lines](int32 i) { return std::regex_search(Utf8Lines[i], StdRegex); });
+        }
+        catch (std::regex_error&) {
+            UE_LOG(LogOutputLogBenchmark, Warning, TEXT("std::regex can not compile the pattern"));
+        }
+    }
+
+    static void BenchmarkRegex(const TArray<FString>& Args)
+    {
+        if (Args.Num() < 1)
+        {
+            UE_LOG(LogOutputLogBenchmark, Display, TEXT("Usage: OutputLogPlus.Benchmark.Regex <LogFile> [SearchPattern]"));
+            return;
+        }
+
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *Args[0]))
+        {
+            UE_LOG(LogOutputLogBenchmark, Warning, TEXT("Could not read %s"), *Args[0]);
+            return;
+        }
+
+        TArray<std::string> Utf8Lines;
+        Utf8Lines.Reserve(Lines.Num());
+        for (const FString& Line : Lines)
+        {
+            Utf8Lines.Add(std::string(TCHAR_TO_UTF8(*Line)));
+        }
+        UE_LOG(LogOutputLogBenchmark, Display, TEXT("Loaded %d lines from %s"), Lines.Num(), *Args[0]);
+
+        // The anti spam filter runs on almost every message, the search is case insensitive like the search box
+        CompareRegex(GetDefault<ULogDisplaySettings>()->AntiSpamRegex, false, Lines, Utf8Lines);
+        const FLogAntiSpamMatcher AntiSpamMatcher(GetDefault<ULogDisplaySettings>()->AntiSpamRegex);
+        UE_LOG(LogOutputLogBenchmark, Display, TEXT("Anti spam matcher: %d literals, regular expressions: %s"), AntiSpamMatcher.NumLiterals(), AntiSpamMatcher.GetRegexPatterns().Num() > 0 ? *FString::Join(AntiSpamMatcher.GetRegexPatterns(), TEXT(", ")) : TEXT("none"));
+        Measure(TEXT("FLogAntiSpamMatcher"), Lines.Num(), [&AntiSpamMatcher, &Lines](int32 i) { return AntiSpamMatcher.IsMatch(*Lines[i], Lines[i].Len()); });
+        FString SearchPattern = TEXT("error|warning");
+        if (Args.Num() > 1)
+        {
+            // The console splits the pattern at spaces
+            SearchPattern = FString::Join(TArray<FString>(Args.GetData() + 1, Args.Num() - 1), TEXT(" "));
+        }
+        CompareRegex(SearchPattern, true, Lines, Utf8Lines);
+    }
+
+    static void BenchmarkLiteral(const TArray<FString>& Args)
+    {
+        if (Args.Num() < 2)
+        {
+            UE_LOG(LogOutputLogBenchmark, Display, TEXT("Usage: OutputLogPlus.Benchmark.Literal <LogFile> <SearchText>"));
+            return;
+        }
+
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *Args[0]))
+        {
+            UE_LOG(LogOutputLogBenchmark, Warning, TEXT("Could not read %s"), *Args[0]);
+            return;
+        }
+        UE_LOG(LogOutputLogBenchmark, Display, TEXT("Loaded %d lines from %s, searching for %s"), Lines.Num(), *Args[0], *Args[1]);
+
+        // The text filter passes the search term upper case, the log view used to copy every message before comparing it
+        const FTextFilterString Value(Args[1]);
+        Measure(TEXT("TextFilterUtils"), Lines.Num(), [&Value, &Lines](int32 i)
+        {
+            return TextFilterUtils::TestBasicStringExpression(FString(Lines[i].Len(), *Lines[i]), Value, ETextFilterTextComparisonMode::Partial);
+        });
+        Measure(TEXT("FString::Contains"), Lines.Num(), [&Args, &Lines](int32 i) { return Lines[i].Contains(Args[1], ESearchCase::IgnoreCase); });
+
+        const FString& Pattern = Value.AsString();
+        Measure(TEXT("FLogLiteralSearch"), Lines.Num(), [&Pattern, &Lines](int32 i) { return FLogLiteralSearch::Contains(*Lines[i], Lines[i].Len(), *Pattern, Pattern.Len()); });
+    }
+
+    static void BenchmarkLinks(const TArray<FString>& Args)
+    {
+        if (Args.Num() < 1)
+        {
+            UE_LOG(LogOutputLogBenchmark, Display, TEXT("Usage: OutputLogPlus.Benchmark.Links <LogFile> [UrlPattern]"));
+            return;
+        }
+
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *Args[0]))
+        {
+            UE_LOG(LogOutputLogBenchmark, Warning, TEXT("Could not read %s"), *Args[0]);
+            return;
+        }
+        UE_LOG(LogOutputLogBenchmark, Display, TEXT("Loaded %d lines from %s"), Lines.Num(), *Args[0]);
+
+        // Copying the text is the lower bound for anything that looks at every character
+        TArray<TCHAR> Buffer;
+        Measure(TEXT("Memcpy"), Lines.Num(), [&Buffer, &Lines](int32 i)
+        {
+            Buffer.SetNumUninitialized(Lines[i].Len() + 1, false);
+            FMemory::Memcpy(Buffer.GetData(), *Lines[i], (Lines[i].Len() + 1) * sizeof(TCHAR));
+            return Buffer[0] == ':';
+        });
+
+        FLogLinkScanner::FWindows Windows;
+        Measure(TEXT("FLogLinkScanner"), Lines.Num(), [&Windows, &Lines](int32 i)
+        {
+            FLogLinkScanner::FindWindows(*Lines[i], Lines[i].Len(), true, true, Windows);
+            return Windows.Urls.Num() > 0 || Windows.Paths.Num() > 0;
+        });
+
+        // A shorter form of the URL pattern of the log view, the matcher runs on the windows the scanner found
+        const FRegexPattern UrlPattern(Args.Num() > 1 ? Args[1] : FString(TEXT("\\b(((https?://)?www\\d{0,3}[.]|(https?://))[^\\s()<>]+)")));
+        Measure(TEXT("FRegexMatcher"), Lines.Num(), [&UrlPattern, &Lines](int32 i)
+        {
+            FRegexMatcher Matcher(UrlPattern, Lines[i]);
+            return Matcher.FindNext();
+        });
+        Measure(TEXT("Scanner and matcher"), Lines.Num(), [&Windows, &UrlPattern, &Lines](int32 i)
+        {
+            FLogLinkScanner::FindWindows(*Lines[i], Lines[i].Len(), true, false, Windows);
+            for (const FTextRange& Window : Windows.Urls)
+            {
+                FRegexMatcher Matcher(UrlPattern, Lines[i].Mid(Window.BeginIndex, Window.Len()));
+                if (Matcher.FindNext())
+                {
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+}
+
+static FAutoConsoleCommand BenchmarkRegexCommand(
+    TEXT("OutputLogPlus.Benchmark.Regex"),
+    TEXT("Compares the output log regex engine with std::regex on the lines of a log file. Usage: OutputLogPlus.Benchmark.Regex <LogFile> [SearchPattern]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&LogBenchmarks::BenchmarkRegex)
+);
+
+static FAutoConsoleCommand BenchmarkLiteralCommand(
+    TEXT("OutputLogPlus.Benchmark.Literal"),
+    TEXT("Compares the literal search of the text filter with the generic text filter comparison on the lines of a log file. Usage: OutputLogPlus.Benchmark.Literal <LogFile> <SearchText>"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&LogBenchmarks::BenchmarkLiteral)
+);
+
+static FAutoConsoleCommand BenchmarkLinksCommand(
+    TEXT("OutputLogPlus.Benchmark.Links"),
+    TEXT("Compares the link trigger scan with copying the text and with running the URL pattern on every line of a log file. Usage: OutputLogPlus.Benchmark.Links <LogFile> [UrlPattern]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&LogBenchmarks::BenchmarkLinks)
+);
@@ -0,0 +1,128 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogCategoryMatcher.h"
+#include "LogDisplaySettings.h"
+#include "LogMessageStore.h"
+#include "LogLiteralSearch.h"
+
+/** Expression context to test a message against the filter expression of a log category */
+class FLogCategory_TextFilterExpressionContext : public ITextFilterExpressionContext
+{
+public:
+    FLogCategory_TextFilterExpressionContext(const FLogMessage& InMessage) : Message(&InMessage) {
+    }
+
+    virtual bool TestBasicStringExpression(const FTextFilterString& InValue, const ETextFilterTextComparisonMode InTextComparisonMode) const override {
+        // Searched in place like in the expression context of FLogFilter, so testing a message does not copy its text
+        return FLogLiteralSearch::Compare(Message->Text, Message->Len, InValue.AsString(), InTextComparisonMode);
+    }
+
+    virtual bool TestComplexExpression(const FName& InKey, const FTextFilterString& InValue, const ETextFilterComparisonOperation InComparisonOperation, const ETextFilterTextComparisonMode InTextComparisonMode) const override { return false; }
+
+private:
+    const FLogMessage* Message;
+};
+
+void FLogCategoryMatcher::Compile(const TArray<FLogCategorySetting>& Categories)
+{
+    PlainTerms.Reset();
+    PlainTermCategories.Reset();
+    ExpressionMatchers.Reset();
+
+    for (int32 CategoryIndex = 0; CategoryIndex < Categories.Num(); CategoryIndex++)
+    {
+        const FLogCategorySetting& Category = Categories[CategoryIndex];
+        if (Category.CategorySearchString.IsEmpty())
+        {
+            continue;
+        }
+
+        if (Category.SearchAsRegex)
+        {
+            FExpressionMatcher Matcher;
+            Matcher.CategoryIndex = CategoryIndex;
+            Matcher.Regex = MakeShareable(new FLogRegex(Category.CategorySearchString, ELogRegexFlags::IgnoreCase));
+            if (Matcher.Regex->IsValid()) {
+                ExpressionMatchers.Add(Matcher);
+            }
+            // otherwise just ignore the log category
+        }
+        else if (IsPlainSearchTerm(Category.CategorySearchString))
+        {
+            // If two categories use the same term, the first one wins
+            const int32 PatternIndex = PlainTerms.AddPattern(Category.CategorySearchString);
+            if (PatternIndex == PlainTermCategories.Num())
+            {
+                PlainTermCategories.Add(CategoryIndex);
+            }
+        }
+        else
+        {
+            FExpressionMatcher Matcher;
+            Matcher.CategoryIndex = CategoryIndex;
+            Matcher.Evaluator = MakeShareable(new FTextFilterExpressionEvaluator(ETextFilterExpressionEvaluatorMode::BasicString));
+            Matcher.Evaluator->SetFilterText(FText::FromString(Category.CategorySearchString));
+            ExpressionMatchers.Add(Matcher);
+        }
+    }
+
+    PlainTerms.Build();
+}
+
+int32 FLogCategoryMatcher::FindFirstMatch(const FLogMessage& Message) const
+{
+    int32 FirstMatch = INDEX_NONE;
+    if (PlainTerms.NumPatterns() > 0)
+    {
+        PlainTerms.FindAll(Message.Text, Message.Len, [this, &FirstMatch](int32 PatternIndex, int32, int32)
+        {
+            const int32 CategoryIndex = PlainTermCategories[PatternIndex];
+            if (FirstMatch == INDEX_NONE || CategoryIndex < FirstMatch)
+            {
+                FirstMatch = CategoryIndex;
+            }
+            // Nothing can beat the first category
+            return FirstMatch != 0;
+        });
+    }
+
+    for (const FExpressionMatcher& Matcher : ExpressionMatchers)
+    {
+        if (FirstMatch != INDEX_NONE && Matcher.CategoryIndex > FirstMatch)
+        {
+            break;
+        }
+
+        bool isMatch = false;
+        if (Matcher.Regex.IsValid()) {
+            isMatch = Matcher.Regex->IsMatch(Message.Text, Message.Len);
+        }
+        else {
+            isMatch = Matcher.Evaluator->TestTextFilter(FLogCategory_TextFilterExpressionContext(Message));
+        }
+
+        if (isMatch) {
+            return Matcher.CategoryIndex;
+        }
+    }
+    return FirstMatch;
+}
+
+bool FLogCategoryMatcher::IsPlainSearchTerm(const FString& SearchString)
+{
+    // The basic string evaluator treats these words as operators
+    if (SearchString == TEXT("AND") || SearchString == TEXT("OR") || SearchString == TEXT("NOT"))
+    {
+        return false;
+    }
+
+    for (TCHAR Char : SearchString)
+    {
+        const bool bIsPlain = FChar::IsAlnum(Char) || Char == TEXT('_') || Char == TEXT('.') || Char == TEXT('/') || Char == TEXT('#') || Char == TEXT('[') || Char == TEXT(']');
+        if (!bIsPlain)
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,48 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AhoCorasick.h"
+#include "Misc/TextFilterExpressionEvaluator.h"
+#include "LogRegex.h"
+
+struct FLogMessage;
+struct FLogCategorySetting;
+
+/**
+ * Finds the first log category (as configured in the display settings) matching a message.
+ *
+ * All search strings are compiled once. Plain search terms are combined into one automaton, so they are tested in a single pass
+ * over the message. Regular expressions and complex filter expressions are only tested if they precede the first plain term match.
+ */
+class FLogCategoryMatcher
+{
+public:
+    /** Compiles the given categories, invalid regular expressions are ignored */
+    void Compile(const TArray<FLogCategorySetting>& Categories);
+
+    /** Returns the index of the first category matching the message or INDEX_NONE if none matches */
+    int32 FindFirstMatch(const FLogMessage& Message) const;
+
+private:
+    /** Returns true if the search string is a single term without any filter expression syntax */
+    static bool IsPlainSearchTerm(const FString& SearchString);
+
+    /** A category that has to be tested on its own */
+    struct FExpressionMatcher
+    {
+        int32 CategoryIndex;
+        TSharedPtr<FLogRegex> Regex;
+        TSharedPtr<FTextFilterExpressionEvaluator> Evaluator;
+    };
+
+    /** Matches all plain search terms at once */
+    FAhoCorasick PlainTerms;
+
+    /** Index of the first category using the plain term, indexed by the pattern index of the term */
+    TArray<int32> PlainTermCategories;
+
+    /** All other categories, ordered by category index */
+    TArray<FExpressionMatcher> ExpressionMatchers;
+};
@@ -0,0 +1,14 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogDisplaySettings.h"
+
+#if WITH_EDITOR
+void ULogDisplaySettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Use the outer property, so a change inside a log category reports the LogCategories array
+    const FName PropertyName = PropertyChangedEvent.MemberProperty ? PropertyChangedEvent.MemberProperty->GetFName() : NAME_None;
+    SettingChangedEvent.Broadcast(PropertyName);
+}
+#endif
@@ -0,0 +1,44 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogFilterResultCache.h"
+
+FLogFilterResultCache::FLogFilterResultCache(int32 InMaxMessages)
+    : Generation(1)
+{
+    // One extra word, because the messages of a full store can span one more block than the capacity suggests
+    Words.SetNum(FMath::DivideAndRoundUp(FMath::Max(InMaxMessages, 1), 64) + 1);
+}
+
+void FLogFilterResultCache::AddWord(uint64 Block, uint64 KnownBits, uint64 VisibleBits)
+{
+    FResultWord& Word = Words[(int32)(Block % (uint64)Words.Num())];
+    if (Word.Generation != Generation || Word.Block != Block)
+    {
+        Word.Known = 0;
+        Word.Visible = 0;
+        Word.Block = Block;
+        Word.Generation = Generation;
+    }
+
+    Word.Known |= KnownBits;
+    Word.Visible = (Word.Visible & ~KnownBits) | (VisibleBits & KnownBits);
+}
+
+void FLogFilterResultCache::InvalidateVisible()
+{
+    // Words of older generations are unknown anyway, so they can be cleared the same way
+    for (FResultWord& Word : Words)
+    {
+        Word.Known &= ~Word.Visible;
+        Word.Visible = 0;
+    }
+}
+
+void FLogFilterResultCache::InvalidateHidden()
+{
+    for (FResultWord& Word : Words)
+    {
+        Word.Known &= Word.Visible;
+        Word.Visible &= Word.Known;
+    }
+}
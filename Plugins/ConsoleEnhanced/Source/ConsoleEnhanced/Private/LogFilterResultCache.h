@@ -0,0 +1,88 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Caches the filter result of every message of a single log view in a compact bitmap indexed by message sequence number.
+ *
+ * The bitmap is a ring of 64 bit words sized to the capacity of the message store. Each word remembers the block of
+ * sequence numbers and the generation it was written in, so invalidating all results is a single generation bump and
+ * stale words are simply reset the next time they are written.
+ */
+class FLogFilterResultCache
+{
+public:
+    FLogFilterResultCache(int32 InMaxMessages);
+
+    /** Returns true if a filter result is cached for the given message, the result is written to bOutVisible */
+    bool Find(uint64 Sequence, bool& bOutVisible) const
+    {
+        const FResultWord& Word = Words[GetWordIndex(Sequence)];
+        const uint64 Bit = GetBit(Sequence);
+        if (Word.Generation != Generation || Word.Block != GetBlock(Sequence) || !(Word.Known & Bit))
+        {
+            return false;
+        }
+        bOutVisible = (Word.Visible & Bit) != 0;
+        return true;
+    }
+
+    /** Stores the filter result for the given message */
+    void Add(uint64 Sequence, bool bVisible)
+    {
+        const uint64 Bit = GetBit(Sequence);
+        AddWord(GetBlock(Sequence), Bit, bVisible ? Bit : 0);
+    }
+
+    /** Returns the known and visible bits of the 64 messages starting at sequence number Block * 64, only known messages can be visible */
+    void FindWord(uint64 Block, uint64& OutKnown, uint64& OutVisible) const
+    {
+        const FResultWord& Word = Words[(int32)(Block % (uint64)Words.Num())];
+        const bool bValid = Word.Generation == Generation && Word.Block == Block;
+        OutKnown = bValid ? Word.Known : 0;
+        OutVisible = bValid ? Word.Visible & Word.Known : 0;
+    }
+
+    /** Stores the results of the messages starting at sequence number Block * 64 whose bits are set in KnownBits */
+    void AddWord(uint64 Block, uint64 KnownBits, uint64 VisibleBits);
+
+    /** Forgets all cached results */
+    void Invalidate()
+    {
+        Generation++;
+    }
+
+    /** Forgets the results of the messages that passed the filter, for a filter that can only let fewer messages pass */
+    void InvalidateVisible();
+
+    /** Forgets the results of the messages that did not pass the filter, for a filter that can only let more messages pass */
+    void InvalidateHidden();
+
+private:
+    /** Filter results of 64 consecutive messages */
+    struct FResultWord
+    {
+        /** Bit is set if the result for the message is known */
+        uint64 Known = 0;
+
+        /** Bit is set if the message passed the filter, never set for a message whose result is not known */
+        uint64 Visible = 0;
+
+        /** Sequence number of the first message in this word divided by 64 */
+        uint64 Block = 0;
+
+        /** Generation the results were written in */
+        uint32 Generation = 0;
+    };
+
+    static uint64 GetBlock(uint64 Sequence) { return Sequence >> 6; }
+    static uint64 GetBit(uint64 Sequence) { return 1ull << (Sequence & 63); }
+    int32 GetWordIndex(uint64 Sequence) const { return (int32)(GetBlock(Sequence) % (uint64)Words.Num()); }
+
+    TArray<FResultWord> Words;
+
+    /** Results written in older generations are stale */
+    uint32 Generation;
+};
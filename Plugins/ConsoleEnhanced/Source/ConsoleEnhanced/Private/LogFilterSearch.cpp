@@ -0,0 +1,125 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogFilterSearch.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeRWLock.h"
+#include "LogMessageStore.h"
+#include "LogFilterResultCache.h"
+#include "SOutputLog.h"
+
+namespace LogFilterSearchDefs
+{
+    // Number of 64 bit result words checked by a single worker task, 64 words are 4096 messages
+    static const int32 WordsPerChunk = 64;
+}
+
+FLogFilterSearch::FLogFilterSearch(const FLogMessageStore& InMessages, const FLogFilter& InFilter, const FLogFilterResultCache& KnownResults, uint64 InStartSequence, uint64 InEndSequence)
+    : Messages(InMessages)
+    , Filter(MakeUnique<FLogFilter>(InFilter))
+    , StartSequence(InStartSequence)
+    , EndSequence(FMath::Max(InStartSequence, InEndSequence))
+    , FirstBlock(InStartSequence >> 6)
+    , NumCollectedChunks(0)
+    , NumMatches(0)
+{
+    const int32 NumWords = (int32)(((EndSequence + 63) >> 6) - FirstBlock);
+    KnownWords.SetNumUninitialized(NumWords);
+    VisibleWords.SetNumUninitialized(NumWords);
+    for (int32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+    {
+        KnownResults.FindWord(FirstBlock + WordIndex, KnownWords[WordIndex], VisibleWords[WordIndex]);
+    }
+
+    ChunksDone.SetNum(FMath::DivideAndRoundUp(NumWords, LogFilterSearchDefs::WordsPerChunk));
+    const int32 NumChunks = ChunksDone.Num();
+    if (NumChunks > 0)
+    {
+        // ParallelFor blocks until all chunks are done, so it is started from a pool thread instead of the game thread
+        Task = Async(EAsyncExecution::ThreadPool, [this, NumChunks]()
+        {
+            ParallelFor(NumChunks, [this](int32 ChunkIndex) { SearchChunk(ChunkIndex); }, EParallelForFlags::BackgroundPriority);
+        });
+    }
+}
+
+FLogFilterSearch::~FLogFilterSearch()
+{
+    bCancelled = true;
+    if (Task.IsValid())
+    {
+        Task.Wait();
+    }
+}
+
+uint64 FLogFilterSearch::CollectResults(FLogFilterResultCache& OutResults, uint64 FirstValidSequence)
+{
+    while (NumCollectedChunks < ChunksDone.Num() && ChunksDone[NumCollectedChunks])
+    {
+        const int32 FirstWord = NumCollectedChunks * LogFilterSearchDefs::WordsPerChunk;
+        const int32 EndWord = FMath::Min(FirstWord + LogFilterSearchDefs::WordsPerChunk, KnownWords.Num());
+        for (int32 WordIndex = FirstWord; WordIndex < EndWord; WordIndex++)
+        {
+            // Results of evicted messages must not be added, their words in the cache might be used by newer messages already
+            const uint64 KnownBits = KnownWords[WordIndex] & GetRangeMask(WordIndex, FirstValidSequence);
+            if (KnownBits != 0)
+            {
+                OutResults.AddWord(FirstBlock + WordIndex, KnownBits, VisibleWords[WordIndex]);
+                NumMatches += FMath::CountBits(VisibleWords[WordIndex] & KnownBits);
+            }
+        }
+        NumCollectedChunks++;
+    }
+
+    const uint64 CollectedEndBlock = FirstBlock + (uint64)NumCollectedChunks * LogFilterSearchDefs::WordsPerChunk;
+    return FMath::Clamp(CollectedEndBlock << 6, StartSequence, EndSequence);
+}
+
+void FLogFilterSearch::SearchChunk(int32 ChunkIndex)
+{
+    // The text filter expression evaluator is not meant to be used by several threads at once, so the chunks do not share the filter
+    const FLogFilter ChunkFilter(*Filter);
+
+    const int32 FirstWord = ChunkIndex * LogFilterSearchDefs::WordsPerChunk;
+    const int32 EndWord = FMath::Min(FirstWord + LogFilterSearchDefs::WordsPerChunk, KnownWords.Num());
+    for (int32 WordIndex = FirstWord; WordIndex < EndWord; WordIndex++)
+    {
+        if (bCancelled)
+        {
+            return;
+        }
+
+        // The lock keeps the game thread from releasing the messages, it is only held for a single word so ingest never waits long
+        FRWScopeLock ReadLock(Messages.GetReadLock(), SLT_ReadOnly);
+        const uint64 WordStart = (FirstBlock + WordIndex) << 6;
+        uint64 PendingBits = GetRangeMask(WordIndex, Messages.GetFirstSequence()) & ~KnownWords[WordIndex];
+        while (PendingBits != 0)
+        {
+            const uint64 Bit = PendingBits & (~PendingBits + 1);
+            PendingBits &= PendingBits - 1;
+            if (ChunkFilter.IsMessageAllowed(Messages.GetBySequence(WordStart + FMath::CountTrailingZeros64(Bit))))
+            {
+                VisibleWords[WordIndex] |= Bit;
+            }
+            else
+            {
+                VisibleWords[WordIndex] &= ~Bit;
+            }
+            KnownWords[WordIndex] |= Bit;
+        }
+    }
+    ChunksDone[ChunkIndex] = true;
+}
+
+uint64 FLogFilterSearch::GetRangeMask(int32 WordIndex, uint64 MinSequence) const
+{
+    const uint64 WordStart = (FirstBlock + WordIndex) << 6;
+    const uint64 RangeStart = FMath::Max(FMath::Max(StartSequence, MinSequence), WordStart);
+    const uint64 RangeEnd = FMath::Min(EndSequence, WordStart + 64);
+    if (RangeStart >= RangeEnd)
+    {
+        return 0;
+    }
+    const uint64 NumBits = RangeEnd - RangeStart;
+    return (NumBits == 64 ? ~0ull : (1ull << NumBits) - 1) << (RangeStart - WordStart);
+}
@@ -0,0 +1,76 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "HAL/ThreadSafeBool.h"
+
+class FLogMessageStore;
+class FLogFilterResultCache;
+struct FLogFilter;
+
+/**
+ * Checks a range of messages against a copy of a filter on the worker threads, so the game thread never waits for a slow filter.
+ *
+ * The range is split into chunks that are checked in parallel. Finished chunks are collected by the game thread in order,
+ * so a view can show the results of the first chunks while the rest is still being checked. Destroying the search cancels it.
+ */
+class FLogFilterSearch
+{
+public:
+    /**
+     * Starts checking the messages in [InStartSequence, InEndSequence).
+     * Results that are already in the cache are not checked again, they are passed through to CollectResults.
+     */
+    FLogFilterSearch(const FLogMessageStore& InMessages, const FLogFilter& InFilter, const FLogFilterResultCache& KnownResults, uint64 InStartSequence, uint64 InEndSequence);
+
+    /** Cancels the search and waits for the workers, which stop after at most 64 messages */
+    ~FLogFilterSearch();
+
+    /**
+     * Copies the results of the chunks finished since the last call into the cache, in order.
+     * Results of messages before FirstValidSequence are dropped, they belong to messages that have been evicted or cleared.
+     *
+     * @return Sequence number up to which all results have been collected
+     */
+    uint64 CollectResults(FLogFilterResultCache& OutResults, uint64 FirstValidSequence);
+
+    /** Sequence number of the first message after the searched range */
+    uint64 GetEndSequence() const { return EndSequence; }
+
+    /** Returns true once all results have been collected */
+    bool IsFinished() const { return NumCollectedChunks == ChunksDone.Num(); }
+
+    /** Number of collected messages that passed the filter */
+    int32 GetNumMatches() const { return NumMatches; }
+
+private:
+    /** Checks the messages of a single chunk, runs on a worker thread */
+    void SearchChunk(int32 ChunkIndex);
+
+    /** Returns the bits of the given result word whose messages are in [MinSequence, EndSequence) */
+    uint64 GetRangeMask(int32 WordIndex, uint64 MinSequence) const;
+
+    const FLogMessageStore& Messages;
+
+    /** Copy of the filter, so the filter of the view can change while the search is running. Every chunk checks against its own copy of it. */
+    TUniquePtr<FLogFilter> Filter;
+
+    uint64 StartSequence;
+    uint64 EndSequence;
+
+    /** Results of the messages starting at sequence number FirstBlock * 64, one pair of words per 64 messages */
+    uint64 FirstBlock;
+    TArray<uint64> KnownWords;
+    TArray<uint64> VisibleWords;
+
+    /** Set by the worker once the results of the chunk are complete */
+    TArray<FThreadSafeBool> ChunksDone;
+
+    int32 NumCollectedChunks;
+    int32 NumMatches;
+
+    FThreadSafeBool bCancelled;
+    TFuture<void> Task;
+};
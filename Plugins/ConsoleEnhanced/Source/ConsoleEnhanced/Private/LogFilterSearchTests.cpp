@@ -0,0 +1,69 @@
+// Copyright Michael Galetzka, 2017
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformProcess.h"
+#include "LogMessageStore.h"
+#include "LogFilterResultCache.h"
+#include "LogFilterSearch.h"
+#include "SOutputLog.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLogFilterSearchNarrowTest, "OutputLogPlus.FilterSearch.Narrow", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLogFilterSearchNarrowTest::RunTest(const FString& Parameters)
+{
+    // More messages than FilterDefs::MaxMessagesFilteredInline, so a view would check them with a background search
+    const int32 NumMessages = 3 * 4096;
+    const TCHAR* Lines[] = { TEXT("xabcx"), TEXT("xabx"), TEXT("zzz") };
+
+    FLogMessageStore Messages(NumMessages, (int64)NumMessages * 64);
+    for (int32 i = 0; i < NumMessages; i++)
+    {
+        const TCHAR* Line = Lines[i % 3];
+        Messages.Add(Line, FCString::Strlen(Line), ELogVerbosity::Log, NAME_None, NAME_None, 0.0);
+    }
+
+    FLogFilter Filter;
+    Filter.bUseRegex = false;
+    Filter.bAntiSpamMode = false;
+    Filter.bShowCommands = true;
+    Filter.SetFilterText(FText::FromString(TEXT("ab")));
+
+    FLogFilterResultCache Results(NumMessages);
+    const uint64 FirstSequence = Messages.GetFirstSequence();
+    const uint64 EndSequence = Messages.GetEndSequence();
+    for (uint64 Sequence = FirstSequence; Sequence < EndSequence; Sequence++)
+    {
+        Results.Add(Sequence, Filter.IsMessageAllowed(Messages.GetBySequence(Sequence)));
+    }
+
+    // Extending the search text only checks the messages that passed before again, like SOutputLog::OnFilterTextChanged does
+    Filter.SetFilterText(FText::FromString(TEXT("abc")));
+    Results.InvalidateVisible();
+    {
+        FLogFilterSearch Search(Messages, Filter, Results, FirstSequence, EndSequence);
+        while (!Search.IsFinished())
+        {
+            Search.CollectResults(Results, FirstSequence);
+            FPlatformProcess::Sleep(0.001f);
+        }
+        Search.CollectResults(Results, FirstSequence);
+    }
+
+    int32 NumWrong = 0;
+    for (uint64 Sequence = FirstSequence; Sequence < EndSequence; Sequence++)
+    {
+        bool bVisible = false;
+        const bool bExpected = (Sequence - FirstSequence) % 3 == 0;
+        if (!Results.Find(Sequence, bVisible) || bVisible != bExpected)
+        {
+            NumWrong++;
+        }
+    }
+    TestEqual(TEXT("Messages with a wrong result after narrowing the search text"), NumWrong, 0);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,185 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogLinkScanner.h"
+
+// Like the literal search, the vectorized scan tests 8 characters at once, so it needs 2 byte characters
+#define LOG_LINK_SCANNER_SSE2 (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY && !PLATFORM_TCHAR_IS_4_BYTES)
+
+// The file path pattern of the log view differs by platform, so do its triggers
+#define LOG_LINK_SCANNER_UNIX_PATHS (PLATFORM_MAC || PLATFORM_LINUX)
+
+#if LOG_LINK_SCANNER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace LogLinkScannerDefs
+{
+    /** Neither pattern matches across these, except for quoted paths */
+    FORCEINLINE bool IsSeparator(TCHAR Char)
+    {
+        return Char == ' ' || Char == '\n';
+    }
+
+    FORCEINLINE bool IsQuote(TCHAR Char)
+    {
+#if LOG_LINK_SCANNER_UNIX_PATHS
+        return Char == '"';
+#else
+        return Char == '"' || Char == '\'';
+#endif
+    }
+
+    FORCEINLINE bool IsAsciiLetter(TCHAR Char)
+    {
+        return (Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z');
+    }
+
+    /** Separator of the paths the pattern matches, besides the drive letter on Windows */
+#if LOG_LINK_SCANNER_UNIX_PATHS
+    static const TCHAR PathSeparator = '/';
+#else
+    static const TCHAR PathSeparator = '\\';
+#endif
+
+    /** Returns true if a trigger may start at the position, the same test as the vectorized scan does */
+    FORCEINLINE bool IsCandidate(const TCHAR* Text, int32 TextLen, int32 Pos)
+    {
+        const TCHAR Char = Text[Pos];
+        if (Char == 'w')
+        {
+            return Pos + 2 < TextLen && Text[Pos + 1] == 'w' && Text[Pos + 2] == 'w';
+        }
+        return Char == ':' || Char == PathSeparator;
+    }
+
+    /** Adds the span around the trigger at the position, unless the last window contains it already */
+    static void AddWindow(const TCHAR* Text, int32 TextLen, int32 Pos, TArray<FTextRange, TInlineAllocator<4>>& Windows)
+    {
+        const int32 PreviousEnd = Windows.Num() > 0 ? Windows.Last().EndIndex : 0;
+        if (Windows.Num() > 0 && Pos < PreviousEnd)
+        {
+            return;
+        }
+
+        int32 Begin = Pos;
+        while (Begin > PreviousEnd && !IsSeparator(Text[Begin - 1]))
+        {
+            Begin--;
+        }
+        int32 End = Pos + 1;
+        while (End < TextLen && !IsSeparator(Text[End]))
+        {
+            End++;
+        }
+        Windows.Emplace(Begin, End);
+    }
+
+#if LOG_LINK_SCANNER_SSE2
+    /** Returns a mask of the 8 characters at which a trigger may start */
+    FORCEINLINE __m128i FindCandidates(const TCHAR* Text)
+    {
+        const __m128i Chars = _mm_loadu_si128((const __m128i*)Text);
+        const __m128i Colon = _mm_cmpeq_epi16(Chars, _mm_set1_epi16(':'));
+        const __m128i Separator = _mm_cmpeq_epi16(Chars, _mm_set1_epi16(PathSeparator));
+
+        // "www" is found by comparing the characters at the position and the two following ones
+        const __m128i W = _mm_set1_epi16('w');
+        const __m128i Www = _mm_and_si128(_mm_cmpeq_epi16(Chars, W), _mm_and_si128(
+            _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(Text + 1)), W),
+            _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(Text + 2)), W)));
+
+        return _mm_or_si128(_mm_or_si128(Colon, Separator), Www);
+    }
+#endif
+}
+
+void FLogLinkScanner::FindWindows(const TCHAR* Text, int32 TextLen, bool bUrls, bool bPaths, FWindows& OutWindows)
+{
+    using namespace LogLinkScannerDefs;
+
+    OutWindows.Urls.Reset();
+    OutWindows.Paths.Reset();
+    if (!bUrls && !bPaths)
+    {
+        return;
+    }
+
+    auto VisitCandidate = [Text, TextLen, bUrls, bPaths, &OutWindows](int32 Pos)
+    {
+        const TCHAR Char = Text[Pos];
+        bool bUrl = false;
+        bool bPath = false;
+        if (Char == 'w')
+        {
+            bUrl = true;
+        }
+        else if (Char == ':')
+        {
+            bUrl = Pos + 2 < TextLen && Text[Pos + 1] == '/' && Text[Pos + 2] == '/';
+#if !LOG_LINK_SCANNER_UNIX_PATHS
+            // A drive letter followed by a separator
+            bPath = Pos > 0 && IsAsciiLetter(Text[Pos - 1]) && Pos + 1 < TextLen && (Text[Pos + 1] == '\\' || Text[Pos + 1] == '/');
+#endif
+        }
+#if LOG_LINK_SCANNER_UNIX_PATHS
+        else if (Char == '/')
+        {
+            bPath = true;
+        }
+#else
+        else if (Char == '\\')
+        {
+            // A network path starts with two backslashes
+            bPath = Pos + 1 < TextLen && Text[Pos + 1] == '\\';
+        }
+#endif
+
+        if (bUrl && bUrls)
+        {
+            AddWindow(Text, TextLen, Pos, OutWindows.Urls);
+        }
+        if (bPath && bPaths)
+        {
+            AddWindow(Text, TextLen, Pos, OutWindows.Paths);
+        }
+    };
+
+    int32 Pos = 0;
+#if LOG_LINK_SCANNER_SSE2
+    // The test for "www" reads two characters past the 8 tested ones
+    for (; Pos + 10 <= TextLen; Pos += 8)
+    {
+        uint32 Candidates = (uint32)_mm_movemask_epi8(FindCandidates(Text + Pos));
+
+        // Two mask bits per character
+        while (Candidates != 0)
+        {
+            const int32 Offset = (int32)(FMath::CountTrailingZeros(Candidates) >> 1);
+            VisitCandidate(Pos + Offset);
+            Candidates &= ~(3u << (Offset * 2));
+        }
+    }
+#endif
+
+    for (; Pos < TextLen; Pos++)
+    {
+        if (IsCandidate(Text, TextLen, Pos))
+        {
+            VisitCandidate(Pos);
+        }
+    }
+
+    // A quoted path can contain spaces, so the path pattern has to see the whole message
+    if (OutWindows.Paths.Num() > 0)
+    {
+        for (int32 i = 0; i < TextLen; i++)
+        {
+            if (IsQuote(Text[i]))
+            {
+                OutWindows.Paths.Reset();
+                OutWindows.Paths.Emplace(0, TextLen);
+                break;
+            }
+        }
+    }
+}
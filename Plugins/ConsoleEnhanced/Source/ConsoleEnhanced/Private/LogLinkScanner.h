@@ -0,0 +1,30 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Text/TextRange.h"
+
+/**
+ * Finds the parts of a log message the URL and file path patterns of the log view have to run on, so the regular expressions are skipped
+ * for most messages and only run on a few short windows of the others.
+ *
+ * Every URL contains "www" or "://", every file path contains a slash (or on Windows a drive letter or "\\" followed by a separator).
+ * The windows are the spans between spaces and line breaks around these triggers. Apart from quoted paths, neither pattern matches
+ * across a space or line break, so the patterns find exactly the same matches in the windows as in the whole message.
+ * If the message contains a quote, quoted paths can contain spaces and the path window is the whole message.
+ *
+ * With SSE2 the characters are tested for triggers 8 at a time, only the positions of candidates are looked at one by one.
+ */
+struct FLogLinkScanner
+{
+    /** Windows of a message, sorted and not overlapping */
+    struct FWindows
+    {
+        TArray<FTextRange, TInlineAllocator<4>> Urls;
+        TArray<FTextRange, TInlineAllocator<4>> Paths;
+    };
+
+    /** Finds the windows for URLs and file paths, empty if the message can not contain any */
+    static void FindWindows(const TCHAR* Text, int32 TextLen, bool bUrls, bool bPaths, FWindows& OutWindows);
+};
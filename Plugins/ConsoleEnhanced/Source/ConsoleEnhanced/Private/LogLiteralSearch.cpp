@@ -0,0 +1,84 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogLiteralSearch.h"
+
+// The vectorized search compares 8 characters at once, so it needs 2 byte characters
+#define LOG_LITERAL_SEARCH_SSE2 (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY && !PLATFORM_TCHAR_IS_4_BYTES)
+
+#if LOG_LITERAL_SEARCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace LogLiteralSearchDefs
+{
+    /** Folds an ASCII letter to upper case, the way the vectorized search does it */
+    FORCEINLINE TCHAR FoldAscii(TCHAR Char)
+    {
+        return (Char >= 'a' && Char <= 'z') ? (TCHAR)(Char - ('a' - 'A')) : Char;
+    }
+
+    /** Returns true if the character is a candidate for the given upper case pattern character */
+    FORCEINLINE bool IsCandidate(TCHAR Char, TCHAR PatternChar)
+    {
+        // Some characters outside of ASCII are upper cased to ASCII letters, so they always have to be verified
+        return FoldAscii(Char) == PatternChar || (uint32)Char > 0x7F;
+    }
+
+#if LOG_LITERAL_SEARCH_SSE2
+    /** Returns a mask of the 8 characters that are candidates for the pattern character */
+    FORCEINLINE __m128i FindCandidates(__m128i Chars, __m128i PatternChar)
+    {
+        const __m128i IsLower = _mm_and_si128(_mm_cmpgt_epi16(Chars, _mm_set1_epi16('a' - 1)), _mm_cmplt_epi16(Chars, _mm_set1_epi16('z' + 1)));
+        const __m128i Folded = _mm_sub_epi16(Chars, _mm_and_si128(IsLower, _mm_set1_epi16('a' - 'A')));
+        const __m128i IsAscii = _mm_cmpeq_epi16(_mm_and_si128(Chars, _mm_set1_epi16((int16)0xFF80)), _mm_setzero_si128());
+        return _mm_or_si128(_mm_cmpeq_epi16(Folded, PatternChar), _mm_andnot_si128(IsAscii, _mm_set1_epi16(-1)));
+    }
+#endif
+}
+
+int32 FLogLiteralSearch::Find(const TCHAR* Text, int32 TextLen, const TCHAR* Pattern, int32 PatternLen)
+{
+    using namespace LogLiteralSearchDefs;
+
+    if (PatternLen <= 0)
+    {
+        return 0;
+    }
+
+    // Number of positions the pattern can start at
+    const int32 NumPositions = TextLen - PatternLen + 1;
+    const TCHAR FirstChar = Pattern[0];
+    const TCHAR LastChar = Pattern[PatternLen - 1];
+    int32 Pos = 0;
+
+#if LOG_LITERAL_SEARCH_SSE2
+    const __m128i First = _mm_set1_epi16((int16)FirstChar);
+    const __m128i Last = _mm_set1_epi16((int16)LastChar);
+    for (; Pos + 8 <= NumPositions; Pos += 8)
+    {
+        const __m128i FirstChars = _mm_loadu_si128((const __m128i*)(Text + Pos));
+        const __m128i LastChars = _mm_loadu_si128((const __m128i*)(Text + Pos + PatternLen - 1));
+        uint32 Candidates = (uint32)_mm_movemask_epi8(_mm_and_si128(FindCandidates(FirstChars, First), FindCandidates(LastChars, Last)));
+
+        // Two mask bits per character
+        while (Candidates != 0)
+        {
+            const int32 Offset = (int32)(FMath::CountTrailingZeros(Candidates) >> 1);
+            if (EqualsAt(Text + Pos + Offset, Pattern, PatternLen))
+            {
+                return Pos + Offset;
+            }
+            Candidates &= ~(3u << (Offset * 2));
+        }
+    }
+#endif
+
+    for (; Pos < NumPositions; Pos++)
+    {
+        if (IsCandidate(Text[Pos], FirstChar) && IsCandidate(Text[Pos + PatternLen - 1], LastChar) && EqualsAt(Text + Pos, Pattern, PatternLen))
+        {
+            return Pos;
+        }
+    }
+    return INDEX_NONE;
+}
@@ -0,0 +1,57 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/TextFilterUtils.h"
+
+/**
+ * Case insensitive search for a literal pattern in the text of a log message, without copying or converting the text.
+ * The pattern has to be upper case already (as with FString::ToUpper or FTextFilterString), the text is compared using FChar::ToUpper.
+ *
+ * With SSE2 the first and last character of the pattern are compared at 8 positions at once, after folding the ASCII letters
+ * of the text to upper case. Only positions where both characters match (or are not ASCII) are compared character by character.
+ */
+struct FLogLiteralSearch
+{
+    /** Returns the index of the first occurrence of the pattern in the text, or INDEX_NONE if there is none */
+    static int32 Find(const TCHAR* Text, int32 TextLen, const TCHAR* Pattern, int32 PatternLen);
+
+    /** Returns true if the text contains the pattern */
+    static bool Contains(const TCHAR* Text, int32 TextLen, const TCHAR* Pattern, int32 PatternLen)
+    {
+        return Find(Text, TextLen, Pattern, PatternLen) != INDEX_NONE;
+    }
+
+    /** Returns true if the text starts with the pattern, the text has to be at least as long as the pattern */
+    static bool EqualsAt(const TCHAR* Text, const TCHAR* Pattern, int32 PatternLen)
+    {
+        for (int32 i = 0; i < PatternLen; i++)
+        {
+            if (FChar::ToUpper(Text[i]) != Pattern[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Compares the text with the pattern like TextFilterUtils::TestBasicStringExpression, the pattern is an upper case FTextFilterString */
+    static bool Compare(const TCHAR* Text, int32 TextLen, const FString& Pattern, ETextFilterTextComparisonMode ComparisonMode)
+    {
+        const int32 PatternLen = Pattern.Len();
+        switch (ComparisonMode)
+        {
+        case ETextFilterTextComparisonMode::Exact:
+            return TextLen == PatternLen && EqualsAt(Text, *Pattern, PatternLen);
+        case ETextFilterTextComparisonMode::Partial:
+            return Contains(Text, TextLen, *Pattern, PatternLen);
+        case ETextFilterTextComparisonMode::StartsWith:
+            return TextLen >= PatternLen && EqualsAt(Text, *Pattern, PatternLen);
+        case ETextFilterTextComparisonMode::EndsWith:
+            return TextLen >= PatternLen && EqualsAt(Text + TextLen - PatternLen, *Pattern, PatternLen);
+        default:
+            return false;
+        }
+    }
+};
@@ -0,0 +1,105 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogMessageFingerprint.h"
+#include "Hash/CityHash.h"
+
+namespace LogMessageFingerprintDefs
+{
+    // Runs of at least this many hex digits that contain a decimal digit are masked as a whole, shorter ones only lose their digits
+    static const int32 MinHexIdLen = 4;
+
+    // Longest quoted name that is masked, longer quotes are most likely part of the text
+    static const int32 MaxQuotedNameLen = 128;
+
+    // Character replacing a variable token
+    static const TCHAR Placeholder = TEXT('#');
+}
+
+uint64 FLogMessageFingerprint::Compute(const TCHAR* Text, int32 Len, ELogVerbosity::Type Verbosity, FName Category)
+{
+    FTemplateBuffer Template;
+    WriteTemplate(Text, Len, Template);
+    return CityHash64WithSeed((const char*)Template.GetData(), Template.Num() * sizeof(TCHAR), GetSeed(Verbosity, Category));
+}
+
+uint64 FLogMessageFingerprint::ComputeExact(const TCHAR* Text, int32 Len, ELogVerbosity::Type Verbosity, FName Category)
+{
+    return CityHash64WithSeed((const char*)Text, Len * sizeof(TCHAR), GetSeed(Verbosity, Category));
+}
+
+FString FLogMessageFingerprint::GetTemplate(const TCHAR* Text, int32 Len)
+{
+    FTemplateBuffer Template;
+    WriteTemplate(Text, Len, Template);
+    return FString(Template.Num(), Template.GetData());
+}
+
+uint64 FLogMessageFingerprint::GetSeed(ELogVerbosity::Type Verbosity, FName Category)
+{
+    return ((uint64)GetTypeHash(Category) << 8) | (uint64)Verbosity;
+}
+
+void FLogMessageFingerprint::WriteTemplate(const TCHAR* Text, int32 Len, FTemplateBuffer& OutTemplate)
+{
+    using namespace LogMessageFingerprintDefs;
+
+    OutTemplate.Reset(Len);
+    for (int32 i = 0; i < Len;)
+    {
+        const TCHAR Char = Text[i];
+
+        // A quoted name like 'BP_Door_C_3' is masked as a whole, quotes around text with spaces are left alone
+        if ((Char == TEXT('\'') || Char == TEXT('"')) && (i == 0 || !FChar::IsAlnum(Text[i - 1])))
+        {
+            int32 QuoteEnd = i + 1;
+            while (QuoteEnd < Len && QuoteEnd - i <= MaxQuotedNameLen && Text[QuoteEnd] != Char && !FChar::IsWhitespace(Text[QuoteEnd]))
+            {
+                QuoteEnd++;
+            }
+            if (QuoteEnd < Len && QuoteEnd > i + 1 && Text[QuoteEnd] == Char)
+            {
+                OutTemplate.Add(Char);
+                OutTemplate.Add(Placeholder);
+                OutTemplate.Add(Char);
+                i = QuoteEnd + 1;
+                continue;
+            }
+        }
+
+        if (!FChar::IsHexDigit(Char))
+        {
+            OutTemplate.Add(Char);
+            i++;
+            continue;
+        }
+
+        const int32 RunStart = i;
+        bool bHasDigit = false;
+        int32 RunEnd = i;
+        for (; RunEnd < Len && FChar::IsHexDigit(Text[RunEnd]); RunEnd++)
+        {
+            bHasDigit |= FChar::IsDigit(Text[RunEnd]);
+        }
+
+        const bool bIsHexLiteral = RunStart >= 2 && Text[RunStart - 1] == TEXT('x') && Text[RunStart - 2] == TEXT('0');
+        if (bHasDigit && (RunEnd - RunStart >= MinHexIdLen || bIsHexLiteral))
+        {
+            OutTemplate.Add(Placeholder);
+            i = RunEnd;
+            continue;
+        }
+
+        // A short run like "E4" in "UE4" is most likely part of a word, only its numbers are masked
+        for (; i < RunEnd; i++)
+        {
+            if (!FChar::IsDigit(Text[i]))
+            {
+                OutTemplate.Add(Text[i]);
+            }
+            else if (i == RunStart || !FChar::IsDigit(Text[i - 1]))
+            {
+                OutTemplate.Add(Placeholder);
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Computes the fingerprint of a message's template: the message with its variable tokens replaced by a placeholder.
+ *
+ * Variable tokens are numbers, hexadecimal ids (GUIDs, addresses) and quoted names without spaces, so
+ * "Deleted 37 Actors", "Deleted 12 Actors" and "Spawned 'BP_Door_C_3'", "Spawned 'BP_Lamp_C_0'" share a template each.
+ * The fingerprint is computed once when a message is added to the store, so grouping by template never tokenizes a message again.
+ */
+class FLogMessageFingerprint
+{
+public:
+    /** Returns the 64 bit hash of the template of the text, seeded with its category and verbosity */
+    static uint64 Compute(const TCHAR* Text, int32 Len, ELogVerbosity::Type Verbosity, FName Category);
+
+    /** Returns the 64 bit hash of the unchanged text, seeded with its category and verbosity */
+    static uint64 ComputeExact(const TCHAR* Text, int32 Len, ELogVerbosity::Type Verbosity, FName Category);
+
+    /** Returns the template of the text, e.g. "Deleted # Actors" */
+    static FString GetTemplate(const TCHAR* Text, int32 Len);
+
+private:
+    typedef TArray<TCHAR, TInlineAllocator<512>> FTemplateBuffer;
+
+    /** Writes the text with its variable tokens replaced to the buffer */
+    static void WriteTemplate(const TCHAR* Text, int32 Len, FTemplateBuffer& OutTemplate);
+
+    static uint64 GetSeed(ELogVerbosity::Type Verbosity, FName Category);
+};
@@ -0,0 +1,16 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogMessageGroups.h"
+#include "LogMessageFingerprint.h"
+#include "LogMessageStore.h"
+
+uint64 FLogMessageGroups::GetKey(const FLogMessage& Message, bool bByTemplate)
+{
+    // The fingerprint of the template has been computed when the message was added
+    if (bByTemplate)
+    {
+        return Message.Fingerprint;
+    }
+    // The prefix is left out, its timestamp would keep identical messages apart
+    return FLogMessageFingerprint::ComputeExact(Message.Text + Message.PrefixLen, Message.Len - Message.PrefixLen, Message.Verbosity, Message.Category);
+}
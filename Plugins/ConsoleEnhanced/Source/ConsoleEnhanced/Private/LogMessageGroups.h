@@ -0,0 +1,48 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FLogMessage;
+
+/**
+ * Groups the messages of a single log view by their text, so a message repeated anywhere in the log is shown only once.
+ *
+ * Messages are identified by a 64 bit hash of their text (without the timestamp prefix), verbosity and category, so they never have to be compared.
+ * Optionally messages are grouped by the fingerprint of their template instead (see FLogMessageFingerprint), so
+ * "Deleted 37 Actors" and "Deleted 12 Actors" end up in the same group.
+ */
+class FLogMessageGroups
+{
+public:
+    struct FGroup
+    {
+        /** Sequence number of the newest message of the group, the view shows the group in its place */
+        uint64 LastSequence = 0;
+
+        /** Number of times a message of the group has been logged, 0 for a group that has just been added */
+        int32 Count = 0;
+    };
+
+    /** Computes the key of the group the message belongs to */
+    static uint64 GetKey(const FLogMessage& Message, bool bByTemplate);
+
+    /** Returns the group with the given key, adding an empty one if there is none */
+    FGroup& FindOrAdd(uint64 Key) { return Groups.FindOrAdd(Key); }
+
+    const FGroup* Find(uint64 Key) const { return Groups.Find(Key); }
+
+    void Remove(uint64 Key) { Groups.Remove(Key); }
+
+    void Reset() { Groups.Reset(); }
+
+    /** Number of distinct messages */
+    int32 Num() const { return Groups.Num(); }
+
+    /** All groups by their key */
+    const TMap<uint64, FGroup>& GetGroups() const { return Groups; }
+
+private:
+    TMap<uint64, FGroup> Groups;
+};
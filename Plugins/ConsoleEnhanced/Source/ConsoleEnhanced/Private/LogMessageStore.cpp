@@ -0,0 +1,198 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogMessageStore.h"
+#include "Misc/ScopeRWLock.h"
+#include "LogMessageFingerprint.h"
+
+DECLARE_MEMORY_STAT(TEXT("History Memory"), STAT_OutputLogHistoryMemory, STATGROUP_OutputLogPlus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("History Messages"), STAT_OutputLogHistoryMessages, STATGROUP_OutputLogPlus);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("History Bytes Per Message"), STAT_OutputLogHistoryBytesPerMessage, STATGROUP_OutputLogPlus);
+
+namespace LogMessageStoreDefs
+{
+    // Number of characters per text page, longer messages get a page of their own
+    static const int32 TextPageChars = 64 * 1024;
+}
+
+FLogMessageStore::FLogMessageStore(int32 InMaxMessages, int64 InMaxBytes)
+    : FirstChunk(0)
+    , MaxMessages(FMath::Max(InMaxMessages, 1))
+    , MaxBytes(FMath::Max<int64>(InMaxBytes, 0))
+    , NumMessages(0)
+    , NumBytes(0)
+    , FirstSequence(0)
+    , PendingText(nullptr)
+{
+}
+
+TCHAR* FLogMessageStore::BeginMessage(int32 MaxLen)
+{
+    const int32 NumChars = MaxLen + 1;
+    if (TextPages.Num() == 0 || TextPages.Last().Capacity - TextPages.Last().Used < NumChars)
+    {
+        if (SparePage.Capacity >= NumChars)
+        {
+            TextPages.Add(MoveTemp(SparePage));
+            SparePage = FTextPage();
+        }
+        else
+        {
+            FTextPage& NewPage = TextPages.AddDefaulted_GetRef();
+            NewPage.Capacity = FMath::Max(LogMessageStoreDefs::TextPageChars, NumChars);
+            NewPage.Data = MakeUnique<TCHAR[]>(NewPage.Capacity);
+        }
+    }
+
+    FTextPage& Page = TextPages.Last();
+    PendingText = Page.Data.Get() + Page.Used;
+    return PendingText;
+}
+
+void FLogMessageStore::CommitMessage(int32 Len, int32 PrefixLen, ELogVerbosity::Type Verbosity, FName Category, FName Style, double Time)
+{
+    check(PendingText != nullptr);
+    TCHAR* Text = PendingText;
+    PendingText = nullptr;
+
+    // Repeated messages are collapsed into the newest message, the views decide how to display them
+    if (NumMessages > 0 && Last().IsRepetitionOf(Text, Len, Verbosity, Category))
+    {
+        FRWScopeLock WriteLock(Lock, SLT_Write);
+        GetRecord(GetEndSequence() - 1).Count++;
+        return;
+    }
+
+    const int64 MessageBytes = sizeof(FLogMessage) + (Len + 1) * sizeof(TCHAR);
+
+    // Make room for the new message. A single message exceeding the whole budget is still kept.
+    // Eviction never releases the last page, so the pending text stays valid.
+    int32 NumToEvict = 0;
+    int64 BytesAfterEviction = NumBytes;
+    while (NumToEvict < NumMessages && (NumMessages - NumToEvict >= MaxMessages || BytesAfterEviction + MessageBytes > MaxBytes))
+    {
+        BytesAfterEviction -= GetBySequence(FirstSequence + NumToEvict).GetAllocatedSize();
+        NumToEvict++;
+    }
+    RemoveOldest(NumToEvict);
+
+    Text[Len] = TCHAR(0);
+    TextPages.Last().Used += Len + 1;
+
+    // The fingerprint only reads the text, so it is computed before the lock is taken.
+    // The prefix is left out, its timestamp would keep identical messages apart.
+    const uint64 Fingerprint = FLogMessageFingerprint::Compute(Text + PrefixLen, Len - PrefixLen, Verbosity, Category);
+
+    FRWScopeLock WriteLock(Lock, SLT_Write);
+    const uint64 Sequence = GetEndSequence();
+    if ((int32)((Sequence >> RecordChunkBits) - FirstChunk) == RecordChunks.Num())
+    {
+        RecordChunks.Add(SpareChunk.IsValid() ? MoveTemp(SpareChunk) : MakeUnique<FLogMessage[]>(RecordChunkSize));
+    }
+
+    FLogMessage& Message = GetRecord(Sequence);
+    Message.Text = Text;
+    Message.Len = Len;
+    Message.PrefixLen = PrefixLen;
+    Message.Count = 1;
+    Message.Time = Time;
+    Message.Category = Category;
+    Message.Style = Style;
+    Message.Verbosity = Verbosity;
+    Message.Fingerprint = Fingerprint;
+
+    NumMessages++;
+    NumBytes += MessageBytes;
+}
+
+void FLogMessageStore::Add(const TCHAR* Text, int32 Len, ELogVerbosity::Type Verbosity, FName Category, FName Style, double Time)
+{
+    TCHAR* Buffer = BeginMessage(Len);
+    FMemory::Memcpy(Buffer, Text, Len * sizeof(TCHAR));
+    CommitMessage(Len, 0, Verbosity, Category, Style, Time);
+}
+
+void FLogMessageStore::NotifyMessagesAdded()
+{
+    UpdateStats();
+    MessagesAddedEvent.Broadcast();
+}
+
+void FLogMessageStore::Empty()
+{
+    FRWScopeLock WriteLock(Lock, SLT_Write);
+    FirstSequence += NumMessages;
+    NumMessages = 0;
+    NumBytes = 0;
+
+    TextPages.Empty();
+    RecordChunks.Empty();
+    FirstChunk = FirstSequence >> RecordChunkBits;
+    SparePage = FTextPage();
+    SpareChunk.Reset();
+    UpdateStats();
+}
+
+void FLogMessageStore::RemoveOldest(int32 Count)
+{
+    if (Count <= 0)
+    {
+        return;
+    }
+
+    MessagesEvictedEvent.Broadcast(Count);
+
+    // The listeners are notified before the lock is taken, so they can still wait for readers
+    FRWScopeLock WriteLock(Lock, SLT_Write);
+    for (int32 i = 0; i < Count; i++)
+    {
+        NumBytes -= GetBySequence(FirstSequence + i).GetAllocatedSize();
+    }
+    NumMessages -= Count;
+    FirstSequence += Count;
+
+    ReleaseUnusedMemory();
+}
+
+void FLogMessageStore::ReleaseUnusedMemory()
+{
+    // Messages are evicted in the order they have been added, so a page is unused once the oldest message is not in it anymore
+    while (TextPages.Num() > 1 && (NumMessages == 0 || !TextPages[0].Contains(GetBySequence(FirstSequence).Text)))
+    {
+        if (TextPages[0].Capacity == LogMessageStoreDefs::TextPageChars && SparePage.Capacity == 0)
+        {
+            SparePage = MoveTemp(TextPages[0]);
+            SparePage.Used = 0;
+        }
+        TextPages.RemoveAt(0);
+    }
+
+    while (RecordChunks.Num() > 0 && ((FirstChunk + 1) << RecordChunkBits) <= FirstSequence)
+    {
+        if (!SpareChunk.IsValid())
+        {
+            SpareChunk = MoveTemp(RecordChunks[0]);
+        }
+        RecordChunks.RemoveAt(0);
+        FirstChunk++;
+    }
+    if (RecordChunks.Num() == 0)
+    {
+        FirstChunk = FirstSequence >> RecordChunkBits;
+    }
+}
+
+void FLogMessageStore::UpdateStats() const
+{
+    // Count the whole pages and chunks, their unused space is part of the footprint even though it is not counted against the memory budget
+    int64 TotalBytes = (RecordChunks.Num() + (SpareChunk.IsValid() ? 1 : 0)) * (int64)RecordChunkSize * sizeof(FLogMessage);
+    TotalBytes += (int64)SparePage.Capacity * sizeof(TCHAR);
+    for (const FTextPage& Page : TextPages)
+    {
+        TotalBytes += (int64)Page.Capacity * sizeof(TCHAR);
+    }
+    TotalBytes += TextPages.GetAllocatedSize() + RecordChunks.GetAllocatedSize();
+
+    SET_MEMORY_STAT(STAT_OutputLogHistoryMemory, TotalBytes);
+    SET_DWORD_STAT(STAT_OutputLogHistoryMessages, NumMessages);
+    SET_DWORD_STAT(STAT_OutputLogHistoryBytesPerMessage, NumMessages > 0 ? (uint32)(TotalBytes / NumMessages) : 0);
+}
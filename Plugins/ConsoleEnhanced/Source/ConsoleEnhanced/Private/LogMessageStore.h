@@ -0,0 +1,208 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "HAL/CriticalSection.h"
+
+DECLARE_STATS_GROUP(TEXT("OutputLogPlus"), STATGROUP_OutputLogPlus, STATCAT_Advanced);
+
+/**
+* A single log message for the output log, holding a single line of text.
+* The text is owned by the message store, a message is only valid as long as it has not been evicted from the store.
+*/
+struct FLogMessage
+{
+    /** Null terminated text of the message */
+    const TCHAR* Text = nullptr;
+
+    /** Number of characters of the text, without the terminator */
+    int32 Len = 0;
+
+    /** Number of characters at the start of the text taken by the timestamp, verbosity and category prefix */
+    int32 PrefixLen = 0;
+
+    /** How often the message has been logged in a row */
+    int32 Count = 1;
+
+    /** Seconds since the engine has been started when the message was logged */
+    double Time = 0.0;
+
+    /** Fingerprint of the template of the message, the text with numbers, ids and quoted names masked (see FLogMessageFingerprint) */
+    uint64 Fingerprint = 0;
+
+    FName Category;
+    FName Style;
+    ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+
+    /** Returns true if the other message has the same text, verbosity and category */
+    bool IsRepetitionOf(const TCHAR* OtherText, int32 OtherLen, ELogVerbosity::Type OtherVerbosity, FName OtherCategory) const
+    {
+        return Verbosity == OtherVerbosity && Category == OtherCategory && Len == OtherLen && FMemory::Memcmp(Text, OtherText, Len * sizeof(TCHAR)) == 0;
+    }
+
+    /** Returns the number of bytes this message occupies in memory, including its text */
+    int64 GetAllocatedSize() const
+    {
+        return sizeof(FLogMessage) + (Len + 1) * sizeof(TCHAR);
+    }
+};
+
+/**
+ * Ring buffer holding the log history.
+ * Appending is O(1); once either the line limit or the memory budget is exceeded the oldest messages are evicted.
+ * A message that repeats the newest message is not stored again, instead the Count of the newest message is increased.
+ *
+ * The text of the messages is copied into large append-only pages and the messages themselves are stored in fixed size chunks,
+ * so adding a message does not allocate anything unless a page or chunk is full. Pages and chunks are released (or reused)
+ * once all of their messages have been evicted, so a message never moves while it is in the store.
+ *
+ * Every message is identified by a sequence number that increases monotonically over the lifetime of the store,
+ * so listeners can keep track of messages even after older ones have been evicted.
+ * The store is shared by all output log views, each view keeps its own position in the store.
+ *
+ * The store is only modified on the game thread. Other threads may read messages while holding the read lock,
+ * the game thread holds the write lock whenever it changes a message or the number of messages, or releases or reallocates memory.
+ * The text of a message is written before the message is added, so writing it needs no lock.
+ */
+class FLogMessageStore
+{
+public:
+    /** Broadcast right before the given number of oldest messages is evicted, so they can still be inspected */
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnMessagesEvicted, int32 /*NumEvicted*/);
+
+    /** Broadcast after new messages have been added or the newest message has been repeated */
+    DECLARE_MULTICAST_DELEGATE(FOnMessagesAdded);
+
+    FLogMessageStore(int32 InMaxMessages, int64 InMaxBytes);
+
+    /**
+     * Returns a buffer at the end of the text pages to write the text of the next message into.
+     * The text is only added to the store by a following call to CommitMessage.
+     *
+     * @param MaxLen Maximum number of characters that are going to be written, without the terminator
+     */
+    TCHAR* BeginMessage(int32 MaxLen);
+
+    /**
+     * Adds the message whose text has been written to the buffer returned by BeginMessage, evicting the oldest messages if necessary.
+     *
+     * @param Len Number of characters that have actually been written
+     * @param PrefixLen Number of those characters taken by the timestamp, verbosity and category prefix
+     */
+    void CommitMessage(int32 Len, int32 PrefixLen, ELogVerbosity::Type Verbosity, FName Category, FName Style, double Time);
+
+    /** Copies the text into the store and adds it as a message */
+    void Add(const TCHAR* Text, int32 Len, ELogVerbosity::Type Verbosity, FName Category, FName Style, double Time);
+
+    /** Notifies the listeners about the messages added since the last notification */
+    void NotifyMessagesAdded();
+
+    /** Removes all messages */
+    void Empty();
+
+    /** Number of messages currently held */
+    int32 Num() const { return NumMessages; }
+
+    /** Maximum number of messages the store can hold */
+    int32 GetMaxMessages() const { return MaxMessages; }
+
+    /** Returns the newest message */
+    const FLogMessage& Last() const
+    {
+        return GetBySequence(GetEndSequence() - 1);
+    }
+
+    /** Sequence number of the oldest message in the store */
+    uint64 GetFirstSequence() const { return FirstSequence; }
+
+    /** Sequence number the next added message will receive */
+    uint64 GetEndSequence() const { return FirstSequence + NumMessages; }
+
+    /** Returns the message with the given sequence number, which has to be in [GetFirstSequence(), GetEndSequence()) */
+    const FLogMessage& GetBySequence(uint64 Sequence) const
+    {
+        checkSlow(Sequence >= FirstSequence && Sequence < GetEndSequence());
+        return GetRecord(Sequence);
+    }
+
+    /** Number of bytes used by all messages in the store */
+    int64 GetAllocatedBytes() const { return NumBytes; }
+
+    /** Event fired before the oldest messages are evicted */
+    FOnMessagesEvicted& OnMessagesEvicted() { return MessagesEvictedEvent; }
+
+    /** Event fired after new messages have been appended */
+    FOnMessagesAdded& OnMessagesAdded() { return MessagesAddedEvent; }
+
+    /** Lock that has to be held to read messages on any other thread than the game thread */
+    FRWLock& GetReadLock() const { return Lock; }
+
+private:
+    /** Number of messages per record chunk is 1 << RecordChunkBits */
+    static const int32 RecordChunkBits = 10;
+    static const int32 RecordChunkSize = 1 << RecordChunkBits;
+
+    /** Append-only block of message text */
+    struct FTextPage
+    {
+        TUniquePtr<TCHAR[]> Data;
+        int32 Capacity = 0;
+        int32 Used = 0;
+
+        bool Contains(const TCHAR* Text) const
+        {
+            return Text >= Data.Get() && Text < Data.Get() + Capacity;
+        }
+    };
+
+    FLogMessage& GetRecord(uint64 Sequence) const
+    {
+        return RecordChunks[(int32)((Sequence >> RecordChunkBits) - FirstChunk)][Sequence & (RecordChunkSize - 1)];
+    }
+
+    /** Evicts the given number of oldest messages */
+    void RemoveOldest(int32 Count);
+
+    /** Releases the pages and chunks that do not hold any messages anymore */
+    void ReleaseUnusedMemory();
+
+    /** Publishes the current size of the store to the stats system */
+    void UpdateStats() const;
+
+    /** Pages holding the message text, the newest message is in the last page */
+    TArray<FTextPage> TextPages;
+
+    /** Chunks of RecordChunkSize messages, the first one holds the message with sequence number FirstChunk << RecordChunkBits */
+    TArray< TUniquePtr<FLogMessage[]> > RecordChunks;
+    uint64 FirstChunk;
+
+    /** Released page and chunk that are reused before new memory is allocated */
+    FTextPage SparePage;
+    TUniquePtr<FLogMessage[]> SpareChunk;
+
+    /** Maximum number of messages held by the store */
+    int32 MaxMessages;
+
+    /** Maximum number of bytes used by the messages held by the store */
+    int64 MaxBytes;
+
+    /** Number of messages currently held */
+    int32 NumMessages;
+
+    /** Number of bytes currently used by the messages */
+    int64 NumBytes;
+
+    /** Sequence number of the oldest message */
+    uint64 FirstSequence;
+
+    /** Start of the buffer returned by BeginMessage */
+    TCHAR* PendingText;
+
+    /** Held for writing by the game thread while it changes what readers might access */
+    mutable FRWLock Lock;
+
+    FOnMessagesEvicted MessagesEvictedEvent;
+    FOnMessagesAdded MessagesAddedEvent;
+};
@@ -0,0 +1,125 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogPathExistenceCache.h"
+#include "Async/Async.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/ScopeLock.h"
+
+namespace LogPathExistenceCacheDefs
+{
+    // Maximum number of paths remembered, the least recently used ones are dropped first
+    static const int32 MaxEntries = 4096;
+
+    // Seconds after which a path is checked again
+    static const double TimeToLive = 30.0;
+
+    // Maximum number of paths waiting to be checked, further paths are queued once the queue has room again
+    static const int32 MaxQueuedPaths = 1024;
+}
+
+FLogPathExistenceCache::FLogPathExistenceCache()
+    : Entries(LogPathExistenceCacheDefs::MaxEntries)
+    , bWorkerRunning(false)
+{
+}
+
+FLogPathExistenceCache::~FLogPathExistenceCache()
+{
+    bCancelled = true;
+    if (Task.IsValid())
+    {
+        Task.Wait();
+    }
+}
+
+ELogPathState FLogPathExistenceCache::Find(const FString& Path)
+{
+    ELogPathState State = ELogPathState::Unknown;
+    const FEntry* Entry = Entries.FindAndTouch(Path);
+    if (Entry)
+    {
+        State = Entry->bExists ? ELogPathState::Exists : ELogPathState::Missing;
+        if (FPlatformTime::Seconds() - Entry->CheckTime < LogPathExistenceCacheDefs::TimeToLive)
+        {
+            return State;
+        }
+    }
+
+    if (PendingPaths.Contains(Path))
+    {
+        return State;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    if (QueuedPaths.Num() >= LogPathExistenceCacheDefs::MaxQueuedPaths)
+    {
+        return State;
+    }
+    QueuedPaths.Add(Path);
+    PendingPaths.Add(Path);
+    if (!bWorkerRunning)
+    {
+        bWorkerRunning = true;
+        Task = Async(EAsyncExecution::ThreadPool, [this]() { CheckQueuedPaths(); });
+    }
+    return State;
+}
+
+bool FLogPathExistenceCache::CollectResults(TArray<TPair<FString, bool>>& OutFirstResults)
+{
+    TArray<TPair<FString, bool>> Results;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (FinishedChecks.Num() == 0)
+        {
+            return false;
+        }
+        Results = MoveTemp(FinishedChecks);
+    }
+
+    bool bChanged = false;
+    const double Now = FPlatformTime::Seconds();
+    for (const TPair<FString, bool>& Result : Results)
+    {
+        const FEntry* OldEntry = Entries.Find(Result.Key);
+        if (OldEntry == nullptr)
+        {
+            OutFirstResults.Add(Result);
+        }
+        else
+        {
+            bChanged |= OldEntry->bExists != Result.Value;
+        }
+
+        FEntry Entry;
+        Entry.bExists = Result.Value;
+        Entry.CheckTime = Now;
+        Entries.Add(Result.Key, Entry);
+        PendingPaths.Remove(Result.Key);
+    }
+    return bChanged;
+}
+
+void FLogPathExistenceCache::CheckQueuedPaths()
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    while (!bCancelled)
+    {
+        FString Path;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (QueuedPaths.Num() == 0)
+            {
+                bWorkerRunning = false;
+                return;
+            }
+            Path = QueuedPaths.Pop(false);
+        }
+
+        // On network drives a single check can take milliseconds, the lock is not held meanwhile
+        const bool bExists = PlatformFile.DirectoryExists(*Path) || PlatformFile.FileExists(*Path);
+
+        FScopeLock ScopeLock(&Lock);
+        FinishedChecks.Emplace(MoveTemp(Path), bExists);
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+
+/** What is known about a file path found in a log message */
+enum class ELogPathState : uint8
+{
+    /** The path has not been checked yet */
+    Unknown,
+    Exists,
+    Missing
+};
+
+/**
+ * Remembers which file paths found in the log exist, so the file path links never touch the file system on the game thread.
+ *
+ * Paths that are not cached yet are checked on a worker thread. Until the result has been collected the path is unknown,
+ * the view shows it as plain text and creates the link once CollectResults reports that it exists.
+ * The cache holds a bounded number of the most recently used paths, and paths are checked again after a while
+ * (their last known state is used until then), so files created or deleted later are picked up as well.
+ */
+class FLogPathExistenceCache
+{
+public:
+    FLogPathExistenceCache();
+
+    /** Cancels the pending checks and waits for the worker, which stops after the path it is checking */
+    ~FLogPathExistenceCache();
+
+    /** Returns the state of the path, queueing a check if it is unknown or has not been checked for a while. Game thread only. */
+    ELogPathState Find(const FString& Path);
+
+    /**
+     * Moves the results of the finished checks into the cache and adds the paths checked for the first time to OutFirstResults,
+     * with whether they exist. Returns true if the state of a path that had been checked before has changed.
+     */
+    bool CollectResults(TArray<TPair<FString, bool>>& OutFirstResults);
+
+private:
+    /** Checks the queued paths until there are none left, runs on a worker thread */
+    void CheckQueuedPaths();
+
+    struct FEntry
+    {
+        bool bExists = false;
+
+        /** FPlatformTime::Seconds() when the path was checked */
+        double CheckTime = 0.0;
+    };
+
+    TLruCache<FString, FEntry> Entries;
+
+    /** Paths that are queued or being checked, so they are only queued once */
+    TSet<FString> PendingPaths;
+
+    /** Guards the queue, the results and bWorkerRunning */
+    FCriticalSection Lock;
+
+    TArray<FString> QueuedPaths;
+    TArray<TPair<FString, bool>> FinishedChecks;
+    bool bWorkerRunning;
+
+    FThreadSafeBool bCancelled;
+    TFuture<void> Task;
+};
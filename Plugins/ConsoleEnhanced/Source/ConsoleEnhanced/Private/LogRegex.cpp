@@ -0,0 +1,1440 @@
+// Copyright Michael Galetzka, 2017
+
+#include "LogRegex.h"
+#include "Algo/Sort.h"
+#include "Misc/Crc.h"
+#include "LogLiteralSearch.h"
+
+namespace LogRegexDefs
+{
+    // Highest code point a character set can contain
+    static const uint32 MaxChar = 0x10FFFF;
+
+    // Highest count allowed in a {n,m} quantifier
+    static const int32 MaxRepeat = 1000;
+
+    // Patterns needing more NFA nodes are rejected
+    static const int32 MaxNodes = 100000;
+
+    // Deepest nesting of groups and of the parsed expression, the parser and the passes over the expression recurse that deep
+    static const int32 MaxNestingDepth = 256;
+
+    // Limits for the DFA, the NFA is simulated if they are exceeded
+    static const int32 MaxDfaStates = 4096;
+    static const int32 MaxDfaEntries = 1 << 21;
+
+    // Limits for the literal analysis, a node matching more strings is not treated as literal anymore
+    static const int32 MaxExactLiterals = 16;
+    static const int32 MaxLiteralLen = 64;
+    static const int32 MaxRequiredLiterals = 64;
+
+    // A character set is treated as literal if its characters fold to at most this many upper case ASCII characters
+    static const int32 MaxLiteralSetChars = 4;
+
+    // Required literals shorter than this reject too few lines to be worth searching for
+    static const int32 MinRequiredLiteralLen = 2;
+
+    // Up to this many required literals are searched one after another, more are searched at once by an Aho-Corasick automaton
+    static const int32 MaxSeparatelySearchedLiterals = 3;
+}
+
+/** Inclusive range of characters */
+struct FLogRegexCharRange
+{
+    uint32 Lo;
+    uint32 Hi;
+};
+
+typedef TArray<FLogRegexCharRange> FLogRegexCharSet;
+
+/** Parses a pattern and compiles it into the NFA of a FLogRegex */
+class FLogRegexCompiler
+{
+public:
+    FLogRegexCompiler(FLogRegex& InRegex, const FString& InPattern, ELogRegexFlags InFlags)
+        : Regex(InRegex)
+        , Pattern(InPattern)
+        , Pos(0)
+        , GroupDepth(0)
+        , bIgnoreCase(EnumHasAnyFlags(InFlags, ELogRegexFlags::IgnoreCase))
+    {
+    }
+
+    /** Compiles the pattern, the error is stored in the regex if it fails */
+    bool Compile()
+    {
+        const int32 Root = ParseAlternation();
+        if (!HasError() && Pos < Pattern.Len())
+        {
+            // The only thing that can stop the top level alternation early is a closing parenthesis
+            Fail(TEXT("Unmatched )"));
+        }
+        if (HasError())
+        {
+            return false;
+        }
+
+        const FFragment Fragment = Emit(Root);
+        const int32 MatchNode = AddNode(FLogRegex::ENodeType::Match);
+        if (HasError())
+        {
+            return false;
+        }
+        Regex.Nodes[Fragment.End].Out = MatchNode;
+        Regex.StartNode = Fragment.Start;
+        Regex.bAnchoredStart = IsAnchoredAtStart(Root);
+
+        const TArray<FString> RequiredLiterals = GetBestLiterals(AnalyzeLiterals(Root));
+        if (GetMinLen(RequiredLiterals) >= LogRegexDefs::MinRequiredLiteralLen)
+        {
+            Regex.RequiredLiterals = RequiredLiterals;
+        }
+
+        BuildClasses();
+        return true;
+    }
+
+private:
+    enum class EAstType : uint8
+    {
+        CharSet,
+        Concat,
+        Alternation,
+        Repeat,
+        Assert,
+    };
+
+    struct FAstNode
+    {
+        EAstType Type;
+        FLogRegex::EAssertion Assertion = FLogRegex::EAssertion::TextStart;
+        int32 CharSet = INDEX_NONE;
+        TArray<int32> Children;
+        /** Nesting depth of the subexpression, 1 for a leaf */
+        int32 Height = 1;
+        int32 Min = 0;
+        /** Upper bound of a repetition, INDEX_NONE if unbounded */
+        int32 Max = 0;
+    };
+
+    /** Part of the NFA with a single entry and a single exit, the exit is an Empty node whose Out has not been set yet */
+    struct FFragment
+    {
+        int32 Start;
+        int32 End;
+    };
+
+    bool HasError() const
+    {
+        return !Regex.Error.IsEmpty();
+    }
+
+    int32 Fail(const TCHAR* Message)
+    {
+        if (!HasError())
+        {
+            Regex.Error = FString::Printf(TEXT("%s at position %d"), Message, Pos);
+        }
+        return INDEX_NONE;
+    }
+
+    bool IsAtEnd() const
+    {
+        return Pos >= Pattern.Len();
+    }
+
+    TCHAR Peek(int32 Offset = 0) const
+    {
+        return Pos + Offset < Pattern.Len() ? Pattern[Pos + Offset] : TEXT('\0');
+    }
+
+    TCHAR Next()
+    {
+        return Pattern[Pos++];
+    }
+
+    int32 AddAst(EAstType Type)
+    {
+        const int32 Index = Ast.AddDefaulted();
+        Ast[Index].Type = Type;
+        return Index;
+    }
+
+    /** Sets the height of a node whose children have been added, fails if the expression is nested too deeply */
+    int32 FinishNode(int32 Node)
+    {
+        for (int32 Child : Ast[Node].Children)
+        {
+            Ast[Node].Height = FMath::Max(Ast[Node].Height, Ast[Child].Height + 1);
+        }
+        return Ast[Node].Height > LogRegexDefs::MaxNestingDepth ? Fail(TEXT("Pattern nested too deeply")) : Node;
+    }
+
+    int32 AddCharSet(FLogRegexCharSet&& Set)
+    {
+        Normalize(Set);
+        if (bIgnoreCase)
+        {
+            AddCaseVariants(Set);
+        }
+        const int32 Node = AddAst(EAstType::CharSet);
+        Ast[Node].CharSet = CharSets.Add(MoveTemp(Set));
+        return Node;
+    }
+
+    int32 AddAssertion(FLogRegex::EAssertion Assertion)
+    {
+        if (Assertion == FLogRegex::EAssertion::WordBoundary || Assertion == FLogRegex::EAssertion::NotWordBoundary)
+        {
+            Regex.bUsesWordBoundary = true;
+        }
+        const int32 Node = AddAst(EAstType::Assert);
+        Ast[Node].Assertion = Assertion;
+        return Node;
+    }
+
+    int32 ParseAlternation()
+    {
+        TArray<int32> Alternatives;
+        Alternatives.Add(ParseConcat());
+        while (!HasError() && Peek() == TEXT('|'))
+        {
+            Pos++;
+            Alternatives.Add(ParseConcat());
+        }
+        if (HasError())
+        {
+            return INDEX_NONE;
+        }
+        if (Alternatives.Num() == 1)
+        {
+            return Alternatives[0];
+        }
+
+        const int32 Node = AddAst(EAstType::Alternation);
+        Ast[Node].Children = MoveTemp(Alternatives);
+        return FinishNode(Node);
+    }
+
+    int32 ParseConcat()
+    {
+        TArray<int32> Items;
+        while (!IsAtEnd() && Peek() != TEXT('|') && Peek() != TEXT(')'))
+        {
+            const int32 Item = ParseRepeat();
+            if (HasError())
+            {
+                return INDEX_NONE;
+            }
+            Items.Add(Item);
+        }
+        if (Items.Num() == 1)
+        {
+            return Items[0];
+        }
+
+        const int32 Node = AddAst(EAstType::Concat);
+        Ast[Node].Children = MoveTemp(Items);
+        return FinishNode(Node);
+    }
+
+    int32 ParseRepeat()
+    {
+        const TCHAR First = Peek();
+        if (First == TEXT('*') || First == TEXT('+') || First == TEXT('?'))
+        {
+            return Fail(TEXT("Nothing to repeat"));
+        }
+
+        int32 Atom = ParseAtom();
+        int32 Min, Max;
+        while (!HasError() && ParseQuantifier(Min, Max))
+        {
+            const int32 Node = AddAst(EAstType::Repeat);
+            Ast[Node].Children.Add(Atom);
+            Ast[Node].Min = Min;
+            Ast[Node].Max = Max;
+            Atom = FinishNode(Node);
+        }
+        return HasError() ? INDEX_NONE : Atom;
+    }
+
+    /** Parses a quantifier following an atom, returns false if there is none */
+    bool ParseQuantifier(int32& OutMin, int32& OutMax)
+    {
+        const TCHAR Char = Peek();
+        if (Char == TEXT('*'))
+        {
+            OutMin = 0;
+            OutMax = INDEX_NONE;
+            Pos++;
+        }
+        else if (Char == TEXT('+'))
+        {
+            OutMin = 1;
+            OutMax = INDEX_NONE;
+            Pos++;
+        }
+        else if (Char == TEXT('?'))
+        {
+            OutMin = 0;
+            OutMax = 1;
+            Pos++;
+        }
+        else if (Char == TEXT('{'))
+        {
+            // A brace that does not start a valid quantifier is taken literally
+            int32 End = Pos + 1;
+            if (!ParseNumber(End, OutMin))
+            {
+                return false;
+            }
+            OutMax = OutMin;
+            if (End < Pattern.Len() && Pattern[End] == TEXT(','))
+            {
+                End++;
+                if (!ParseNumber(End, OutMax))
+                {
+                    OutMax = INDEX_NONE;
+                }
+            }
+            if (End >= Pattern.Len() || Pattern[End] != TEXT('}'))
+            {
+                return false;
+            }
+            Pos = End + 1;
+
+            if (OutMin > LogRegexDefs::MaxRepeat || OutMax > LogRegexDefs::MaxRepeat)
+            {
+                Fail(TEXT("Repetition count too large"));
+                return false;
+            }
+            if (OutMax != INDEX_NONE && OutMax < OutMin)
+            {
+                Fail(TEXT("Invalid repetition range"));
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        // Without captures there is no difference between lazy and greedy matching
+        if (Peek() == TEXT('?'))
+        {
+            Pos++;
+        }
+        return true;
+    }
+
+    bool ParseNumber(int32& InOutPos, int32& OutNumber) const
+    {
+        const int32 Start = InOutPos;
+        int64 Number = 0;
+        while (InOutPos < Pattern.Len() && FChar::IsDigit(Pattern[InOutPos]))
+        {
+            Number = FMath::Min<int64>(Number * 10 + (Pattern[InOutPos] - TEXT('0')), MAX_int32);
+            InOutPos++;
+        }
+        OutNumber = (int32)Number;
+        return InOutPos > Start;
+    }
+
+    int32 ParseAtom()
+    {
+        const TCHAR Char = Next();
+        switch (Char)
+        {
+        case TEXT('('):
+        {
+            if (Peek() == TEXT('?'))
+            {
+                Pos++;
+                const TCHAR GroupType = IsAtEnd() ? TEXT('\0') : Next();
+                if (GroupType == TEXT('=') || GroupType == TEXT('!'))
+                {
+                    return Fail(TEXT("Lookahead is not supported"));
+                }
+                if (GroupType == TEXT('<'))
+                {
+                    return Fail(TEXT("Lookbehind and named groups are not supported"));
+                }
+                if (GroupType != TEXT(':'))
+                {
+                    return Fail(TEXT("Invalid group"));
+                }
+            }
+
+            // Groups add no node to the expression, but every group is a level of recursion of the parser
+            if (GroupDepth >= LogRegexDefs::MaxNestingDepth)
+            {
+                return Fail(TEXT("Pattern nested too deeply"));
+            }
+            GroupDepth++;
+            const int32 Inner = ParseAlternation();
+            GroupDepth--;
+            if (HasError())
+            {
+                return INDEX_NONE;
+            }
+            if (IsAtEnd() || Next() != TEXT(')'))
+            {
+                return Fail(TEXT("Missing )"));
+            }
+            return Inner;
+        }
+        case TEXT('['):
+            return ParseClass();
+        case TEXT('.'):
+        {
+            // Any character except line terminators
+            FLogRegexCharSet Set = { { 0, 9 }, { 11, 12 }, { 14, 0x2027 }, { 0x202A, LogRegexDefs::MaxChar } };
+            return AddCharSet(MoveTemp(Set));
+        }
+        case TEXT('^'):
+            return AddAssertion(FLogRegex::EAssertion::TextStart);
+        case TEXT('$'):
+            return AddAssertion(FLogRegex::EAssertion::TextEnd);
+        case TEXT('\\'):
+            return ParseEscape();
+        default:
+        {
+            FLogRegexCharSet Set = { { (uint32)Char, (uint32)Char } };
+            return AddCharSet(MoveTemp(Set));
+        }
+        }
+    }
+
+    int32 ParseEscape()
+    {
+        if (IsAtEnd())
+        {
+            return Fail(TEXT("Trailing backslash"));
+        }
+
+        const TCHAR Char = Next();
+        if (Char == TEXT('b'))
+        {
+            return AddAssertion(FLogRegex::EAssertion::WordBoundary);
+        }
+        if (Char == TEXT('B'))
+        {
+            return AddAssertion(FLogRegex::EAssertion::NotWordBoundary);
+        }
+        if ((Char >= TEXT('1') && Char <= TEXT('9')) || Char == TEXT('k'))
+        {
+            return Fail(TEXT("Backreferences are not supported"));
+        }
+
+        FLogRegexCharSet Set;
+        if (!GetClassEscape(Char, Set))
+        {
+            const uint32 Code = ParseCharEscape(Char);
+            Set.Add({ Code, Code });
+        }
+        return HasError() ? INDEX_NONE : AddCharSet(MoveTemp(Set));
+    }
+
+    /** Parses the escaped character of an escape sequence that stands for a single character */
+    uint32 ParseCharEscape(TCHAR Char)
+    {
+        switch (Char)
+        {
+        case TEXT('t'): return 9;
+        case TEXT('n'): return 10;
+        case TEXT('v'): return 11;
+        case TEXT('f'): return 12;
+        case TEXT('r'): return 13;
+        case TEXT('0'): return 0;
+        case TEXT('x'): return ParseHex(2);
+        case TEXT('u'): return ParseHex(4);
+        case TEXT('c'):
+            if (FChar::IsAlpha(Peek()))
+            {
+                return (uint32)Next() % 32;
+            }
+            return Char;
+        default:
+            // Escaped punctuation and unknown escapes stand for the character itself
+            return Char;
+        }
+    }
+
+    uint32 ParseHex(int32 NumDigits)
+    {
+        uint32 Code = 0;
+        for (int32 i = 0; i < NumDigits; i++)
+        {
+            const TCHAR Char = Peek();
+            if (!FChar::IsHexDigit(Char))
+            {
+                Fail(TEXT("Invalid hexadecimal escape"));
+                return 0;
+            }
+            Code = Code * 16 + FParse::HexDigit(Char);
+            Pos++;
+        }
+        return Code;
+    }
+
+    /** Adds the characters of \d \D \w \W \s \S to the set, returns false for any other escape */
+    static bool GetClassEscape(TCHAR Char, FLogRegexCharSet& OutSet)
+    {
+        FLogRegexCharSet Set;
+        switch (FChar::ToLower(Char))
+        {
+        case TEXT('d'):
+            Set = GetDigitSet();
+            break;
+        case TEXT('w'):
+            Set = GetWordSet();
+            break;
+        case TEXT('s'):
+            Set = GetSpaceSet();
+            break;
+        default:
+            return false;
+        }
+        if (FChar::IsUpper(Char))
+        {
+            Set = Complement(Set);
+        }
+        OutSet.Append(Set);
+        return true;
+    }
+
+    int32 ParseClass()
+    {
+        const bool bNegate = Peek() == TEXT('^');
+        if (bNegate)
+        {
+            Pos++;
+        }
+
+        FLogRegexCharSet Set;
+        for (;;)
+        {
+            if (IsAtEnd())
+            {
+                return Fail(TEXT("Missing ]"));
+            }
+
+            uint32 Lo;
+            if (!ParseClassChar(Set, Lo))
+            {
+                if (HasError())
+                {
+                    return INDEX_NONE;
+                }
+                if (Pattern[Pos - 1] == TEXT(']'))
+                {
+                    break;
+                }
+                // \d and friends can not start a range
+                continue;
+            }
+
+            uint32 Hi = Lo;
+            if (Peek() == TEXT('-') && Pos + 1 < Pattern.Len() && Pattern[Pos + 1] != TEXT(']'))
+            {
+                Pos++;
+                if (!ParseClassChar(Set, Hi) || Hi < Lo)
+                {
+                    return Fail(TEXT("Invalid range in character class"));
+                }
+            }
+            Set.Add({ Lo, Hi });
+        }
+
+        if (bNegate)
+        {
+            // Negation applies to the case folded set
+            Normalize(Set);
+            if (bIgnoreCase)
+            {
+                AddCaseVariants(Set);
+            }
+            Set = Complement(Set);
+            const int32 Node = AddAst(EAstType::CharSet);
+            Ast[Node].CharSet = CharSets.Add(MoveTemp(Set));
+            return Node;
+        }
+        return AddCharSet(MoveTemp(Set));
+    }
+
+    /**
+     * Parses a single character of a character class
+     *
+     * @return false for the closing bracket and for class escapes like \d, which are added to the set directly
+     */
+    bool ParseClassChar(FLogRegexCharSet& Set, uint32& OutChar)
+    {
+        const TCHAR Char = Next();
+        if (Char == TEXT(']'))
+        {
+            return false;
+        }
+        if (Char != TEXT('\\'))
+        {
+            OutChar = Char;
+            return true;
+        }
+
+        if (IsAtEnd())
+        {
+            Fail(TEXT("Trailing backslash"));
+            return false;
+        }
+        const TCHAR Escaped = Next();
+        if (GetClassEscape(Escaped, Set))
+        {
+            return false;
+        }
+        // Inside a class \b is a backspace
+        OutChar = Escaped == TEXT('b') ? 8 : ParseCharEscape(Escaped);
+        return !HasError();
+    }
+
+    static FLogRegexCharSet GetDigitSet()
+    {
+        return { { '0', '9' } };
+    }
+
+    static FLogRegexCharSet GetWordSet()
+    {
+        return { { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' } };
+    }
+
+    static FLogRegexCharSet GetSpaceSet()
+    {
+        return { { 9, 13 }, { ' ', ' ' }, { 0xA0, 0xA0 }, { 0x1680, 0x1680 }, { 0x2000, 0x200A }, { 0x2028, 0x2029 }, { 0x202F, 0x202F }, { 0x205F, 0x205F }, { 0x3000, 0x3000 }, { 0xFEFF, 0xFEFF } };
+    }
+
+    /** Sorts the ranges and merges overlapping and adjacent ones */
+    static void Normalize(FLogRegexCharSet& Set)
+    {
+        Algo::SortBy(Set, &FLogRegexCharRange::Lo);
+        int32 NumMerged = 0;
+        for (const FLogRegexCharRange& Range : Set)
+        {
+            if (NumMerged > 0 && Range.Lo <= Set[NumMerged - 1].Hi + 1)
+            {
+                Set[NumMerged - 1].Hi = FMath::Max(Set[NumMerged - 1].Hi, Range.Hi);
+            }
+            else
+            {
+                Set[NumMerged++] = Range;
+            }
+        }
+        Set.SetNum(NumMerged);
+    }
+
+    static FLogRegexCharSet Complement(FLogRegexCharSet Set)
+    {
+        Normalize(Set);
+        FLogRegexCharSet Result;
+        uint32 Next = 0;
+        for (const FLogRegexCharRange& Range : Set)
+        {
+            if (Range.Lo > Next)
+            {
+                Result.Add({ Next, Range.Lo - 1 });
+            }
+            Next = Range.Hi + 1;
+        }
+        if (Next <= LogRegexDefs::MaxChar)
+        {
+            Result.Add({ Next, LogRegexDefs::MaxChar });
+        }
+        return Result;
+    }
+
+    /** Adds the other case of all letters in the set */
+    static void AddCaseVariants(FLogRegexCharSet& Set)
+    {
+        // Checking every character is too expensive for huge ranges, those are only folded in the Latin range where most letters are
+        static const uint32 AlwaysFoldedEnd = 0x250;
+        static const uint32 MaxFoldedRange = 512;
+        static const uint32 MaxTChar = sizeof(TCHAR) == 2 ? 0xFFFF : LogRegexDefs::MaxChar;
+
+        const int32 NumRanges = Set.Num();
+        for (int32 i = 0; i < NumRanges; i++)
+        {
+            const FLogRegexCharRange Range = Set[i];
+            const uint32 End = Range.Hi - Range.Lo < MaxFoldedRange ? Range.Hi : FMath::Min(Range.Hi, AlwaysFoldedEnd - 1);
+            for (uint32 Code = Range.Lo; Code <= End && Code <= MaxTChar; Code++)
+            {
+                const uint32 Lower = (uint32)FChar::ToLower((TCHAR)Code);
+                const uint32 Upper = (uint32)FChar::ToUpper((TCHAR)Code);
+                if (Lower != Code)
+                {
+                    Set.Add({ Lower, Lower });
+                }
+                if (Upper != Code)
+                {
+                    Set.Add({ Upper, Upper });
+                }
+            }
+        }
+        Normalize(Set);
+    }
+
+    int32 AddNode(FLogRegex::ENodeType Type)
+    {
+        if (Regex.Nodes.Num() >= LogRegexDefs::MaxNodes)
+        {
+            Fail(TEXT("Expression too complex"));
+            return 0;
+        }
+        NodeCharSets.Add(INDEX_NONE);
+        const int32 Index = Regex.Nodes.AddDefaulted();
+        Regex.Nodes[Index].Type = Type;
+        return Index;
+    }
+
+    FFragment MakeEmptyFragment()
+    {
+        const int32 Node = AddNode(FLogRegex::ENodeType::Empty);
+        return { Node, Node };
+    }
+
+    /** Chains the fragments, returns an empty fragment if there are none */
+    FFragment Concat(const TArray<FFragment>& Fragments)
+    {
+        if (Fragments.Num() == 0)
+        {
+            return MakeEmptyFragment();
+        }
+        for (int32 i = 0; i + 1 < Fragments.Num(); i++)
+        {
+            Regex.Nodes[Fragments[i].End].Out = Fragments[i + 1].Start;
+        }
+        return { Fragments[0].Start, Fragments.Last().End };
+    }
+
+    FFragment Emit(int32 AstIndex)
+    {
+        if (HasError())
+        {
+            return { 0, 0 };
+        }
+
+        const FAstNode& AstNode = Ast[AstIndex];
+        switch (AstNode.Type)
+        {
+        case EAstType::CharSet:
+        {
+            const int32 Node = AddNode(FLogRegex::ENodeType::Char);
+            const int32 End = AddNode(FLogRegex::ENodeType::Empty);
+            if (HasError())
+            {
+                return { 0, 0 };
+            }
+            NodeCharSets[Node] = AstNode.CharSet;
+            Regex.Nodes[Node].Out = End;
+            return { Node, End };
+        }
+        case EAstType::Assert:
+        {
+            const int32 Node = AddNode(FLogRegex::ENodeType::Assert);
+            const int32 End = AddNode(FLogRegex::ENodeType::Empty);
+            if (HasError())
+            {
+                return { 0, 0 };
+            }
+            Regex.Nodes[Node].Assertion = AstNode.Assertion;
+            Regex.Nodes[Node].Out = End;
+            return { Node, End };
+        }
+        case EAstType::Concat:
+        {
+            TArray<FFragment> Fragments;
+            for (int32 Child : AstNode.Children)
+            {
+                Fragments.Add(Emit(Child));
+            }
+            return HasError() ? FFragment{ 0, 0 } : Concat(Fragments);
+        }
+        case EAstType::Alternation:
+        {
+            const int32 End = AddNode(FLogRegex::ENodeType::Empty);
+            int32 Start = INDEX_NONE;
+            int32 LastSplit = INDEX_NONE;
+            for (int32 i = 0; i < AstNode.Children.Num() && !HasError(); i++)
+            {
+                const FFragment Alternative = Emit(AstNode.Children[i]);
+                if (HasError())
+                {
+                    break;
+                }
+                Regex.Nodes[Alternative.End].Out = End;
+
+                // The last alternative is reached through the second edge of the previous split
+                int32 Entry = Alternative.Start;
+                if (i + 1 < AstNode.Children.Num())
+                {
+                    Entry = AddNode(FLogRegex::ENodeType::Split);
+                    Regex.Nodes[Entry].Out = Alternative.Start;
+                }
+                if (LastSplit == INDEX_NONE)
+                {
+                    Start = Entry;
+                }
+                else
+                {
+                    Regex.Nodes[LastSplit].Out1 = Entry;
+                }
+                LastSplit = Entry;
+            }
+            return HasError() ? FFragment{ 0, 0 } : FFragment{ Start, End };
+        }
+        case EAstType::Repeat:
+        {
+            const int32 Child = AstNode.Children[0];
+            const int32 Min = AstNode.Min;
+            const int32 Max = AstNode.Max;
+
+            TArray<FFragment> Fragments;
+            for (int32 i = 0; i < Min && !HasError(); i++)
+            {
+                Fragments.Add(Emit(Child));
+            }
+            if (Max == INDEX_NONE)
+            {
+                const int32 Split = AddNode(FLogRegex::ENodeType::Split);
+                const FFragment Loop = Emit(Child);
+                const int32 End = AddNode(FLogRegex::ENodeType::Empty);
+                if (!HasError())
+                {
+                    Regex.Nodes[Split].Out = Loop.Start;
+                    Regex.Nodes[Split].Out1 = End;
+                    Regex.Nodes[Loop.End].Out = Split;
+                    Fragments.Add({ Split, End });
+                }
+            }
+            else
+            {
+                for (int32 i = Min; i < Max && !HasError(); i++)
+                {
+                    const int32 Split = AddNode(FLogRegex::ENodeType::Split);
+                    const FFragment Optional = Emit(Child);
+                    const int32 End = AddNode(FLogRegex::ENodeType::Empty);
+                    if (!HasError())
+                    {
+                        Regex.Nodes[Split].Out = Optional.Start;
+                        Regex.Nodes[Split].Out1 = End;
+                        Regex.Nodes[Optional.End].Out = End;
+                        Fragments.Add({ Split, End });
+                    }
+                }
+            }
+            return HasError() ? FFragment{ 0, 0 } : Concat(Fragments);
+        }
+        }
+        return { 0, 0 };
+    }
+
+    bool IsAnchoredAtStart(int32 AstIndex) const
+    {
+        const FAstNode& AstNode = Ast[AstIndex];
+        switch (AstNode.Type)
+        {
+        case EAstType::Assert:
+            return AstNode.Assertion == FLogRegex::EAssertion::TextStart;
+        case EAstType::Concat:
+            return AstNode.Children.Num() > 0 && IsAnchoredAtStart(AstNode.Children[0]);
+        case EAstType::Alternation:
+            for (int32 Child : AstNode.Children)
+            {
+                if (!IsAnchoredAtStart(Child))
+                {
+                    return false;
+                }
+            }
+            return true;
+        case EAstType::Repeat:
+            return AstNode.Min > 0 && IsAnchoredAtStart(AstNode.Children[0]);
+        default:
+            return false;
+        }
+    }
+
+    /** Strings contained in the matches of an AST node, all upper case */
+    struct FLiteralInfo
+    {
+        /** True if every match of the node is one of the Exact strings, ignoring case */
+        bool bExact = false;
+        TArray<FString> Exact;
+
+        /** Every match of the node contains at least one of these strings, empty if nothing is known */
+        TArray<FString> Required;
+    };
+
+    static int32 GetMinLen(const TArray<FString>& Literals)
+    {
+        if (Literals.Num() == 0)
+        {
+            return 0;
+        }
+        int32 MinLen = MAX_int32;
+        for (const FString& Literal : Literals)
+        {
+            MinLen = FMath::Min(MinLen, Literal.Len());
+        }
+        return MinLen;
+    }
+
+    /** Returns the set of literals that rejects the most texts, the shortest literal of a set decides */
+    static const TArray<FString>& GetBetterLiterals(const TArray<FString>& A, const TArray<FString>& B)
+    {
+        const int32 MinLenA = GetMinLen(A);
+        const int32 MinLenB = GetMinLen(B);
+        if (MinLenA != MinLenB)
+        {
+            return MinLenA > MinLenB ? A : B;
+        }
+        return A.Num() <= B.Num() ? A : B;
+    }
+
+    static TArray<FString> GetBestLiterals(const FLiteralInfo& Info)
+    {
+        return Info.bExact ? GetBetterLiterals(Info.Exact, Info.Required) : Info.Required;
+    }
+
+    static void AddUnique(TArray<FString>& Literals, const FString& Literal)
+    {
+        if (!Literals.Contains(Literal))
+        {
+            Literals.Add(Literal);
+        }
+    }
+
+    /** Appends every string of B to every string of A, returns false if the result would exceed the limits */
+    static bool CrossLiterals(const TArray<FString>& A, const TArray<FString>& B, TArray<FString>& OutLiterals)
+    {
+        if (A.Num() * B.Num() > LogRegexDefs::MaxExactLiterals)
+        {
+            return false;
+        }
+        TArray<FString> Result;
+        for (const FString& Prefix : A)
+        {
+            for (const FString& Suffix : B)
+            {
+                if (Prefix.Len() + Suffix.Len() > LogRegexDefs::MaxLiteralLen)
+                {
+                    return false;
+                }
+                AddUnique(Result, Prefix + Suffix);
+            }
+        }
+        OutLiterals = MoveTemp(Result);
+        return true;
+    }
+
+    /**
+     * Computes which strings the matches of an AST node have to contain. Only ASCII characters are treated as literal,
+     * because their case variants are the same for FChar::ToUpper and FChar::ToLower, so a search ignoring the case never misses a match.
+     */
+    FLiteralInfo AnalyzeLiterals(int32 AstIndex) const
+    {
+        const FAstNode& AstNode = Ast[AstIndex];
+        FLiteralInfo Info;
+        switch (AstNode.Type)
+        {
+        case EAstType::CharSet:
+        {
+            TArray<FString> Chars;
+            for (const FLogRegexCharRange& Range : CharSets[AstNode.CharSet])
+            {
+                if (Range.Hi > 127 || Range.Hi - Range.Lo >= 26)
+                {
+                    return Info;
+                }
+                for (uint32 Code = Range.Lo; Code <= Range.Hi; Code++)
+                {
+                    AddUnique(Chars, FString::Chr(FChar::ToUpper((TCHAR)Code)));
+                    if (Chars.Num() > LogRegexDefs::MaxLiteralSetChars)
+                    {
+                        return Info;
+                    }
+                }
+            }
+            Info.bExact = true;
+            Info.Exact = MoveTemp(Chars);
+            return Info;
+        }
+        case EAstType::Assert:
+            // Assertions do not consume characters, so they do not break a literal
+            Info.bExact = true;
+            Info.Exact.Add(FString());
+            return Info;
+        case EAstType::Concat:
+        {
+            // Consecutive exact children form runs of literals, the best run or required set of a child is required for the whole node
+            TArray<FString> Run;
+            Run.Add(FString());
+            bool bAllExact = true;
+            for (int32 Child : AstNode.Children)
+            {
+                const FLiteralInfo ChildInfo = AnalyzeLiterals(Child);
+                Info.Required = GetBetterLiterals(Info.Required, ChildInfo.Required);
+                if (ChildInfo.bExact && CrossLiterals(Run, ChildInfo.Exact, Run))
+                {
+                    continue;
+                }
+
+                bAllExact = false;
+                Info.Required = GetBetterLiterals(Info.Required, Run);
+                Run.Reset();
+                Run.Add(FString());
+                if (ChildInfo.bExact)
+                {
+                    Run = ChildInfo.Exact;
+                }
+            }
+            Info.Required = GetBetterLiterals(Info.Required, Run);
+            if (bAllExact)
+            {
+                Info.bExact = true;
+                Info.Exact = MoveTemp(Run);
+            }
+            return Info;
+        }
+        case EAstType::Alternation:
+        {
+            // Every alternative has to contribute a literal, otherwise nothing is required
+            Info.bExact = true;
+            bool bAllRequired = true;
+            for (int32 Child : AstNode.Children)
+            {
+                const FLiteralInfo ChildInfo = AnalyzeLiterals(Child);
+                if (ChildInfo.bExact && Info.bExact && Info.Exact.Num() + ChildInfo.Exact.Num() <= LogRegexDefs::MaxExactLiterals)
+                {
+                    for (const FString& Literal : ChildInfo.Exact)
+                    {
+                        AddUnique(Info.Exact, Literal);
+                    }
+                }
+                else
+                {
+                    Info.bExact = false;
+                }
+
+                const TArray<FString> ChildLiterals = GetBestLiterals(ChildInfo);
+                if (GetMinLen(ChildLiterals) == 0 || Info.Required.Num() + ChildLiterals.Num() > LogRegexDefs::MaxRequiredLiterals)
+                {
+                    bAllRequired = false;
+                }
+                else if (bAllRequired)
+                {
+                    for (const FString& Literal : ChildLiterals)
+                    {
+                        AddUnique(Info.Required, Literal);
+                    }
+                }
+            }
+            if (!Info.bExact)
+            {
+                Info.Exact.Reset();
+            }
+            if (!bAllRequired)
+            {
+                Info.Required.Reset();
+            }
+            return Info;
+        }
+        case EAstType::Repeat:
+        {
+            const FLiteralInfo ChildInfo = AnalyzeLiterals(AstNode.Children[0]);
+            if (AstNode.Min == 0)
+            {
+                // x? is either empty or x, anything repeated more often is not exact anymore
+                if (AstNode.Max == 1 && ChildInfo.bExact && ChildInfo.Exact.Num() < LogRegexDefs::MaxExactLiterals)
+                {
+                    Info.bExact = true;
+                    Info.Exact = ChildInfo.Exact;
+                    AddUnique(Info.Exact, FString());
+                }
+                return Info;
+            }
+
+            Info.Required = GetBestLiterals(ChildInfo);
+            if (AstNode.Max == AstNode.Min && ChildInfo.bExact)
+            {
+                TArray<FString> Repeated;
+                Repeated.Add(FString());
+                Info.bExact = true;
+                for (int32 i = 0; i < AstNode.Min && Info.bExact; i++)
+                {
+                    Info.bExact = CrossLiterals(Repeated, ChildInfo.Exact, Repeated);
+                }
+                if (Info.bExact)
+                {
+                    Info.Exact = MoveTemp(Repeated);
+                }
+            }
+            return Info;
+        }
+        }
+        return Info;
+    }
+
+    /** Partitions the characters into the classes the NFA can tell apart */
+    void BuildClasses()
+    {
+        TArray<uint32>& ClassStarts = Regex.ClassStarts;
+        ClassStarts.Add(0);
+
+        // Word characters always get their own classes, so a class tells if a word boundary is crossed
+        const FLogRegexCharSet WordSet = GetWordSet();
+        for (const FLogRegexCharRange& Range : WordSet)
+        {
+            ClassStarts.Add(Range.Lo);
+            ClassStarts.Add(Range.Hi + 1);
+        }
+        for (const FLogRegexCharSet& Set : CharSets)
+        {
+            for (const FLogRegexCharRange& Range : Set)
+            {
+                ClassStarts.Add(Range.Lo);
+                if (Range.Hi < LogRegexDefs::MaxChar)
+                {
+                    ClassStarts.Add(Range.Hi + 1);
+                }
+            }
+        }
+        Algo::Sort(ClassStarts);
+        int32 NumUnique = 0;
+        for (uint32 Start : ClassStarts)
+        {
+            if (NumUnique == 0 || ClassStarts[NumUnique - 1] != Start)
+            {
+                ClassStarts[NumUnique++] = Start;
+            }
+        }
+        ClassStarts.SetNum(NumUnique);
+        const int32 NumClasses = ClassStarts.Num();
+
+        Regex.Latin1Classes.SetNum(256);
+        for (uint32 Code = 0; Code < 256; Code++)
+        {
+            Regex.Latin1Classes[Code] = (uint16)(Algo::UpperBound(ClassStarts, Code) - 1);
+        }
+
+        Regex.ClassIsWord.SetNum(NumClasses);
+        for (int32 Class = 0; Class < NumClasses; Class++)
+        {
+            const uint32 Code = ClassStarts[Class];
+            Regex.ClassIsWord[Class] = Code < 128 && (FChar::IsAlnum((TCHAR)Code) || Code == '_');
+        }
+
+        Regex.ClassWords = FMath::DivideAndRoundUp(NumClasses, 64);
+        Regex.ClassBits.SetNumZeroed(Regex.Nodes.Num() * Regex.ClassWords);
+        for (int32 Node = 0; Node < Regex.Nodes.Num(); Node++)
+        {
+            if (NodeCharSets[Node] == INDEX_NONE)
+            {
+                continue;
+            }
+            for (const FLogRegexCharRange& Range : CharSets[NodeCharSets[Node]])
+            {
+                const int32 FirstClass = Algo::UpperBound(ClassStarts, Range.Lo) - 1;
+                const int32 LastClass = Algo::UpperBound(ClassStarts, Range.Hi) - 1;
+                for (int32 Class = FirstClass; Class <= LastClass; Class++)
+                {
+                    Regex.ClassBits[Node * Regex.ClassWords + (Class >> 6)] |= 1ull << (Class & 63);
+                }
+            }
+        }
+    }
+
+    FLogRegex& Regex;
+    const FString& Pattern;
+    int32 Pos;
+
+    /** Number of groups the parser is inside of */
+    int32 GroupDepth;
+
+    bool bIgnoreCase;
+
+    TArray<FAstNode> Ast;
+    TArray<FLogRegexCharSet> CharSets;
+
+    /** Character set of every NFA node, INDEX_NONE for nodes that do not consume characters */
+    TArray<int32> NodeCharSets;
+};
+
+FLogRegex::FLogRegex(const FString& Pattern, ELogRegexFlags Flags)
+    : StartNode(INDEX_NONE)
+    , bAnchoredStart(false)
+    , bUsesWordBoundary(false)
+    , ClassWords(0)
+    , bHasDfa(false)
+{
+    FLogRegexCompiler Compiler(*this, Pattern, Flags);
+    if (!Compiler.Compile())
+    {
+        Nodes.Empty();
+        return;
+    }
+
+    bHasDfa = BuildDfa();
+    if (!bHasDfa)
+    {
+        DfaTransitions.Empty();
+        DfaAcceptsAtEnd.Empty();
+    }
+
+    // A few literals are found faster than the DFA runs, the automaton for many literals is only worth it if the NFA has to be simulated
+    const bool bUseLiteralMatcher = RequiredLiterals.Num() > LogRegexDefs::MaxSeparatelySearchedLiterals;
+    if (bUseLiteralMatcher && bHasDfa)
+    {
+        RequiredLiterals.Empty();
+    }
+    else if (bUseLiteralMatcher)
+    {
+        for (const FString& Literal : RequiredLiterals)
+        {
+            RequiredLiteralMatcher.AddPattern(Literal);
+        }
+        RequiredLiteralMatcher.Build();
+    }
+}
+
+bool FLogRegex::IsMatch(const TCHAR* Text, int32 TextLen) const
+{
+    if (!IsValid())
+    {
+        return false;
+    }
+
+    // Most texts do not contain the literals every match needs, they are rejected without running the expression
+    if (RequiredLiteralMatcher.NumPatterns() > 0)
+    {
+        if (!RequiredLiteralMatcher.ContainsAny(Text, TextLen))
+        {
+            return false;
+        }
+    }
+    else if (RequiredLiterals.Num() > 0)
+    {
+        bool bContainsLiteral = false;
+        for (int32 i = 0; i < RequiredLiterals.Num() && !bContainsLiteral; i++)
+        {
+            bContainsLiteral = FLogLiteralSearch::Contains(Text, TextLen, *RequiredLiterals[i], RequiredLiterals[i].Len());
+        }
+        if (!bContainsLiteral)
+        {
+            return false;
+        }
+    }
+
+    if (!bHasDfa)
+    {
+        return SimulateNfa(Text, TextLen);
+    }
+
+    const int32* Transitions = DfaTransitions.GetData();
+    int32 Row = 0;
+    for (int32 i = 0; i < TextLen; i++)
+    {
+        Row = Transitions[Row + GetClass(Text[i])];
+        if (Row < 0)
+        {
+            return Row == DfaMatch;
+        }
+    }
+    return DfaAcceptsAtEnd[Row / ClassStarts.Num()];
+}
+
+bool FLogRegex::ComputeTransition(const TArray<int32>& CurrentNodes, bool bAtStart, bool bPrevIsWord, int32 Class, FScratch& Scratch, TArray<int32>& OutNext) const
+{
+    const bool bAtEnd = Class == INDEX_NONE;
+    const bool bNextIsWord = !bAtEnd && ClassIsWord[Class];
+
+    if (Scratch.Visited.Num() != Nodes.Num())
+    {
+        Scratch.Visited.SetNumZeroed(Nodes.Num());
+    }
+    if (++Scratch.VisitMark == 0)
+    {
+        FMemory::Memzero(Scratch.Visited.GetData(), Scratch.Visited.Num() * sizeof(uint32));
+        Scratch.VisitMark = 1;
+    }
+
+    Scratch.Closure.Reset();
+    Scratch.Stack.Reset();
+    Scratch.Stack.Append(CurrentNodes);
+    if (!bAnchoredStart || bAtStart)
+    {
+        // Unanchored search, a match can start at every position
+        Scratch.Stack.Add(StartNode);
+    }
+
+    while (Scratch.Stack.Num() > 0)
+    {
+        const int32 NodeIndex = Scratch.Stack.Pop(false);
+        if (Scratch.Visited[NodeIndex] == Scratch.VisitMark)
+        {
+            continue;
+        }
+        Scratch.Visited[NodeIndex] = Scratch.VisitMark;
+
+        const FNode& Node = Nodes[NodeIndex];
+        switch (Node.Type)
+        {
+        case ENodeType::Char:
+            Scratch.Closure.Add(NodeIndex);
+            break;
+        case ENodeType::Match:
+            return true;
+        case ENodeType::Split:
+            Scratch.Stack.Add(Node.Out1);
+            Scratch.Stack.Add(Node.Out);
+            break;
+        case ENodeType::Empty:
+            Scratch.Stack.Add(Node.Out);
+            break;
+        case ENodeType::Assert:
+        {
+            bool bHolds = false;
+            switch (Node.Assertion)
+            {
+            case EAssertion::TextStart:
+                bHolds = bAtStart;
+                break;
+            case EAssertion::TextEnd:
+                bHolds = bAtEnd;
+                break;
+            case EAssertion::WordBoundary:
+                bHolds = bPrevIsWord != bNextIsWord;
+                break;
+            case EAssertion::NotWordBoundary:
+                bHolds = bPrevIsWord == bNextIsWord;
+                break;
+            }
+            if (bHolds)
+            {
+                Scratch.Stack.Add(Node.Out);
+            }
+            break;
+        }
+        }
+    }
+
+    OutNext.Reset();
+    if (bAtEnd)
+    {
+        return false;
+    }
+    for (int32 NodeIndex : Scratch.Closure)
+    {
+        if (NodeAcceptsClass(NodeIndex, Class))
+        {
+            OutNext.Add(Nodes[NodeIndex].Out);
+        }
+    }
+    Algo::Sort(OutNext);
+    int32 NumUnique = 0;
+    for (int32 NodeIndex : OutNext)
+    {
+        if (NumUnique == 0 || OutNext[NumUnique - 1] != NodeIndex)
+        {
+            OutNext[NumUnique++] = NodeIndex;
+        }
+    }
+    OutNext.SetNum(NumUnique, false);
+    return false;
+}
+
+bool FLogRegex::BuildDfa()
+{
+    const int32 NumClasses = ClassStarts.Num();
+
+    // A DFA state is the set of NFA nodes reached so far and whether the last character was a word character
+    TArray<TArray<int32>> StateNodes;
+    TArray<bool> StatePrevIsWord;
+    TMap<uint32, TArray<int32>> StatesByHash;
+    StateNodes.AddDefaulted();
+    StatePrevIsWord.Add(false);
+
+    FScratch Scratch;
+    TArray<int32> Next;
+    for (int32 State = 0; State < StateNodes.Num(); State++)
+    {
+        if (StateNodes.Num() > LogRegexDefs::MaxDfaStates || StateNodes.Num() * NumClasses > LogRegexDefs::MaxDfaEntries)
+        {
+            return false;
+        }
+
+        // The start state is the only one at the start of the text
+        const bool bAtStart = State == 0;
+        const TArray<int32> CurrentNodes = StateNodes[State];
+        const bool bPrevIsWord = StatePrevIsWord[State];
+
+        const int32 Row = DfaTransitions.AddUninitialized(NumClasses);
+        for (int32 Class = 0; Class < NumClasses; Class++)
+        {
+            int32 Target;
+            if (ComputeTransition(CurrentNodes, bAtStart, bPrevIsWord, Class, Scratch, Next))
+            {
+                Target = DfaMatch;
+            }
+            else if (Next.Num() == 0 && bAnchoredStart)
+            {
+                Target = DfaNoMatch;
+            }
+            else
+            {
+                const bool bNextPrevIsWord = bUsesWordBoundary && ClassIsWord[Class];
+                const uint32 Hash = FCrc::MemCrc32(Next.GetData(), Next.Num() * sizeof(int32), bNextPrevIsWord ? 1 : 0);
+                TArray<int32>& Candidates = StatesByHash.FindOrAdd(Hash);
+
+                Target = INDEX_NONE;
+                for (int32 Candidate : Candidates)
+                {
+                    if (StatePrevIsWord[Candidate] == bNextPrevIsWord && StateNodes[Candidate] == Next)
+                    {
+                        Target = Candidate;
+                        break;
+                    }
+                }
+                if (Target == INDEX_NONE)
+                {
+                    Target = StateNodes.Add(Next);
+                    StatePrevIsWord.Add(bNextPrevIsWord);
+                    Candidates.Add(Target);
+                }
+                Target *= NumClasses;
+            }
+            DfaTransitions[Row + Class] = Target;
+        }
+        DfaAcceptsAtEnd.Add(ComputeTransition(CurrentNodes, bAtStart, bPrevIsWord, INDEX_NONE, Scratch, Next));
+    }
+    return true;
+}
+
+bool FLogRegex::SimulateNfa(const TCHAR* Text, int32 TextLen) const
+{
+    FScratch Scratch;
+    TArray<int32> Current;
+    TArray<int32> Next;
+    bool bPrevIsWord = false;
+    for (int32 i = 0; i <= TextLen; i++)
+    {
+        const int32 Class = i < TextLen ? GetClass(Text[i]) : INDEX_NONE;
+        if (ComputeTransition(Current, i == 0, bPrevIsWord, Class, Scratch, Next))
+        {
+            return true;
+        }
+        if (Class == INDEX_NONE || (Next.Num() == 0 && bAnchoredStart))
+        {
+            return false;
+        }
+        Swap(Current, Next);
+        bPrevIsWord = ClassIsWord[Class];
+    }
+    return false;
+}
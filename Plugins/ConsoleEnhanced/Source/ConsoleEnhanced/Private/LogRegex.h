@@ -0,0 +1,171 @@
+// Copyright Michael Galetzka, 2017
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+#include "AhoCorasick.h"
+
+enum class ELogRegexFlags : uint8
+{
+    None = 0,
+
+    /** Letters match regardless of their case */
+    IgnoreCase = 1 << 0,
+};
+ENUM_CLASS_FLAGS(ELogRegexFlags);
+
+/**
+ * Regular expression engine used by the log filters. Matching takes linear time in the length of the text, nothing is ever backtracked.
+ *
+ * The pattern is compiled into an NFA, which is converted into a DFA up front. If the DFA would grow too large, the NFA is simulated
+ * instead, which is slower but still linear. A compiled expression is immutable, so it can be shared and used on multiple threads at once.
+ *
+ * Supported are literals and escapes, ".", character classes, \d \w \s and their negations, groups, alternation, the quantifiers
+ * * + ? {n} {n,} {n,m} (lazy quantifiers are accepted and behave like greedy ones), the anchors ^ $ and the word boundaries \b \B.
+ * Backreferences and lookaround would need backtracking, they are reported as errors.
+ *
+ * Literal strings every match has to contain (e.g. "ERROR" and "TEXTURE" for Error.*Texture) are extracted from the pattern.
+ * Texts that contain none of them are rejected by a fast substring search before the expression runs.
+ */
+class FLogRegex
+{
+public:
+    FLogRegex(const FString& Pattern, ELogRegexFlags Flags = ELogRegexFlags::None);
+
+    /** Returns true if the pattern has been compiled successfully */
+    bool IsValid() const { return Error.IsEmpty(); }
+
+    /** Describes why the pattern could not be compiled */
+    const FString& GetError() const { return Error; }
+
+    /** Returns true if the expression matches anywhere in the text. An invalid expression never matches. */
+    bool IsMatch(const TCHAR* Text, int32 TextLen) const;
+
+    bool IsMatch(const FString& Text) const
+    {
+        return IsMatch(*Text, Text.Len());
+    }
+
+    /** Returns true if the expression has been compiled into a DFA, false if the NFA is simulated */
+    bool HasDfa() const { return bHasDfa; }
+
+    /** Upper case literals of which every match contains at least one, empty if they are not used to reject texts */
+    const TArray<FString>& GetRequiredLiterals() const { return RequiredLiterals; }
+
+private:
+    friend class FLogRegexCompiler;
+
+    enum class ENodeType : uint8
+    {
+        /** Consumes a character of the node's character set */
+        Char,
+        /** Continues with both Out and Out1 */
+        Split,
+        /** Continues with Out */
+        Empty,
+        /** Continues with Out if the assertion holds at the current position */
+        Assert,
+        /** The expression has matched */
+        Match,
+    };
+
+    enum class EAssertion : uint8
+    {
+        TextStart,
+        TextEnd,
+        WordBoundary,
+        NotWordBoundary,
+    };
+
+    struct FNode
+    {
+        ENodeType Type = ENodeType::Empty;
+        EAssertion Assertion = EAssertion::TextStart;
+        int32 Out = INDEX_NONE;
+        int32 Out1 = INDEX_NONE;
+    };
+
+    /** Reusable buffers to compute state transitions */
+    struct FScratch
+    {
+        TArray<int32> Stack;
+        TArray<int32> Closure;
+        TArray<uint32> Visited;
+        uint32 VisitMark = 0;
+    };
+
+    /**
+     * Follows all epsilon edges from the given nodes and the start node, then consumes a character of the given class.
+     *
+     * @param Class Character class of the next character, INDEX_NONE at the end of the text
+     * @param OutNext Receives the sorted nodes reached after consuming the character
+     * @return true if the expression matches before the character is consumed
+     */
+    bool ComputeTransition(const TArray<int32>& CurrentNodes, bool bAtStart, bool bPrevIsWord, int32 Class, FScratch& Scratch, TArray<int32>& OutNext) const;
+
+    /** Builds the DFA, returns false if it exceeds the size limits */
+    bool BuildDfa();
+
+    /** Matches by simulating the NFA, used if there is no DFA */
+    bool SimulateNfa(const TCHAR* Text, int32 TextLen) const;
+
+    int32 GetClass(TCHAR Char) const
+    {
+        const uint32 Code = (uint32)Char;
+        if (Code < 256)
+        {
+            return Latin1Classes[Code];
+        }
+        // The class of a character is the last range starting at or before it
+        return Algo::UpperBound(ClassStarts, Code) - 1;
+    }
+
+    bool NodeAcceptsClass(int32 Node, int32 Class) const
+    {
+        return (ClassBits[Node * ClassWords + (Class >> 6)] & (1ull << (Class & 63))) != 0;
+    }
+
+    static const int32 DfaMatch = -1;
+    static const int32 DfaNoMatch = -2;
+
+    FString Error;
+
+    /** NFA nodes, the expression starts with StartNode */
+    TArray<FNode> Nodes;
+    int32 StartNode;
+
+    /** True if every match has to begin at the start of the text */
+    bool bAnchoredStart;
+
+    /** True if the expression contains word boundaries, only then the previous character has to be tracked */
+    bool bUsesWordBoundary;
+
+    /** The characters are partitioned into classes that no character set of the expression can tell apart, this is the first character of each class */
+    TArray<uint32> ClassStarts;
+
+    /** Class of the first 256 characters for a fast lookup */
+    TArray<uint16> Latin1Classes;
+
+    /** True for the classes consisting of word characters */
+    TArray<bool> ClassIsWord;
+
+    /** For every node the classes accepted by it, ClassWords words per node */
+    TArray<uint64> ClassBits;
+    int32 ClassWords;
+
+    /**
+     * DFA transition table with one row of NumClasses entries per state, the start state is the first row.
+     * An entry is the offset of the target row, or DfaMatch / DfaNoMatch if the result is known.
+     */
+    TArray<int32> DfaTransitions;
+
+    /** True for the DFA states that match at the end of the text, indexed by row */
+    TArray<bool> DfaAcceptsAtEnd;
+
+    bool bHasDfa;
+
+    /** Texts not containing any of these are rejected before the expression runs, several literals are searched at once by the matcher */
+    TArray<FString> RequiredLiterals;
+    FAhoCorasick RequiredLiteralMatcher;
+};
@@ -13,10 +13,53 @@
 #include "BlueprintEditor.h"
 #include "SourceCodeNavigation.h"
 #include "EditorStyleSet.h"
-#include "Classes/EditorStyleSettings.h"
 #include "Subsystems/AssetEditorSubsystem.h"
+#include "Widgets/Layout/SScrollBar.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Fonts/FontMeasure.h"
+#include "LogFilterSearch.h"
+#include "LogLiteralSearch.h"
+#include "LogLinkScanner.h"
+#include "Algo/BinarySearch.h"
 
-using namespace std;
+namespace LinkDefs
+{
+    // Number of messages whose link candidates are remembered
+    static const int32 MaxMemoizedMessages = 16384;
+
+    // Seconds per frame spent on adding the links to the lines of the layout that do not have them yet
+    static const double MaxSecondsPerFrame = 0.002;
+
+    // Maximum number of lines waiting for the checks of their file paths, further lines get their links when they are created again
+    static const int32 MaxLinesWaitingForPaths = 4096;
+}
+
+namespace GroupViewDefs
+{
+    // Indentation of the messages listed below the row of their group
+    static const TCHAR* MessageIndent = TEXT("    ");
+
+    // Seconds between sorting the rows by count again while groups keep changing, the counters of the rows are updated along with them
+    static const double SortInterval = 0.5;
+}
+
+namespace VirtualViewDefs
+{
+    // The rows of evicted messages are only removed from the row array once there are at least this many
+    static const int32 MinRowsToCompact = 4096;
+
+    // Number of rows scrolled per mouse wheel step
+    static const float RowsPerWheelStep = 3.0f;
+
+    // Space between the text and the border of the text box that can not be used for rows
+    static const float VerticalSlack = 4.0f;
+}
+
+namespace FilterDefs
+{
+    // Up to this many unchecked messages are checked on the game thread, more are checked by a background search
+    static const uint64 MaxMessagesFilteredInline = 4096;
+}
 
 #define LOCTEXT_NAMESPACE "SOutputLog"
 
@@ -29,7 +72,8 @@ public:
 
     /** Test the given value against the strings extracted from the current item */
     virtual bool TestBasicStringExpression(const FTextFilterString& InValue, const ETextFilterTextComparisonMode InTextComparisonMode) const override {
-        return TextFilterUtils::TestBasicStringExpression(*Message->Message, InValue, InTextComparisonMode); 
+        // The value is upper case already, so the message can be searched in place instead of copying and converting it
+        return FLogLiteralSearch::Compare(Message->Text, Message->Len, InValue.AsString(), InTextComparisonMode);
     }
 
     /**
@@ -585,19 +629,46 @@ FString SConsoleInputBox::GetSelectionText() const
     return ret;
 }
 
-TSharedRef< FOutputLogTextLayoutMarshaller > FOutputLogTextLayoutMarshaller::Create(TArray< TSharedPtr<FLogMessage> > InMessages, FLogFilter* InFilter)
+TSharedRef< FOutputLogTextLayoutMarshaller > FOutputLogTextLayoutMarshaller::Create(const TSharedRef<FLogMessageStore>& InMessages, const TSharedPtr<FBlueprintLinkIndex>& InBlueprintLinks, FLogFilter* InFilter, bool bInVirtualized)
 {
-    return MakeShareable(new FOutputLogTextLayoutMarshaller(MoveTemp(InMessages), InFilter));
+    TSharedRef<FOutputLogTextLayoutMarshaller> Marshaller = MakeShareable(new FOutputLogTextLayoutMarshaller(InMessages, InBlueprintLinks, InFilter, bInVirtualized));
+    Marshaller->WeakThis = Marshaller;
+    return Marshaller;
 }
 
 FOutputLogTextLayoutMarshaller::~FOutputLogTextLayoutMarshaller()
 {
+    Messages->OnMessagesEvicted().Remove(MessagesEvictedHandle);
+    GetMutableDefault<ULogDisplaySettings>()->OnSettingChanged().Remove(SettingChangedHandle);
 }
 
 void FOutputLogTextLayoutMarshaller::SetText(const FString& SourceString, FTextLayout& TargetTextLayout)
 {
     TextLayout = (FCustomTextLayout*)&TargetTextLayout;
-    AppendMessagesToTextLayout(Messages);
+    if (bVirtualized)
+    {
+        if (bRowsDirty)
+        {
+            RebuildRows();
+        }
+        LinesWaitingForPaths.Reset();
+        NumLinesWaitingForPaths = 0;
+        AddWindowLines();
+        return;
+    }
+
+    LayoutEndSequence = GetViewStartSequence();
+    CachedNumMessages = 0;
+    bNumMessagesCacheDirty = false;
+    Rows.Reset();
+    Groups.Reset();
+    ExpandedMessages.Reset();
+    ExpandedRowsStart = ExpandedRowsEnd = 0;
+    LastGroupSortTime = 0.0;
+    PendingLinkLines.Reset();
+    LinesWaitingForPaths.Reset();
+    NumLinesWaitingForPaths = 0;
+    AppendMessagesToTextLayout(MAX_int32);
 }
 
 void FOutputLogTextLayoutMarshaller::GetText(FString& TargetString, const FTextLayout& SourceTextLayout)
@@ -605,59 +676,270 @@ void FOutputLogTextLayoutMarshaller::GetText(FString& TargetString, const FTextL
     SourceTextLayout.GetAsText(TargetString);
 }
 
-bool FOutputLogTextLayoutMarshaller::AppendMessage(const TCHAR* InText, const ELogVerbosity::Type InVerbosity, const double Time, const FName& InCategory)
+bool FOutputLogTextLayoutMarshaller::AppendPendingMessages(int32 MaxNumLines)
 {
-    TArray< TSharedPtr<FLogMessage> > NewMessages;
-    if (SOutputLog::CreateLogMessages(InText, InVerbosity, InCategory, Time, NewMessages))
+    FilterPendingMessages();
+
+    const bool bHasNewMessages = LayoutEndSequence < Messages->GetEndSequence() ||
+        (LayoutEndSequence > GetViewStartSequence() && Messages->GetBySequence(LayoutEndSequence - 1).Count != LayoutLastMessageCount) ||
+        (Filter->bGroupDuplicates && Filter->bSortGroupsByCount && IsGroupSortDue());
+    if (!bHasNewMessages)
     {
-        const bool bWasEmpty = Messages.Num() == 0;
+        return false;
+    }
 
-        if (Filter->bCollapsedMode && NewMessages.Num() == 1 && Messages.Num() > 0) {
-            auto PrevMessage = Messages.Last();
-            if (NewMessages[0]->Message->Equals(*PrevMessage->Message)) {
-                PrevMessage->Count += 1;
-                if (Filter->IsMessageAllowed(PrevMessage))
-                {
-                    TextLayout->RemoveLine(TextLayout->GetLineModels().Num() - 1);
-                }
-                NewMessages[0] = Messages.Pop(false);
-            }
+    if (bVirtualized)
+    {
+        if (bRowsDirty)
+        {
+            // The next refresh builds all rows anyway
+            return false;
+        }
+
+        // New rows, or a new counter of the last row, only need to be shown if the window reaches the end.
+        // Grouped rows move to the end when their group changes, so they can leave the window anywhere.
+        const bool bWindowAtEnd = WindowStart + WindowSize >= Rows.Num();
+        if (AppendMessagesToRows(MaxNumLines) && (bWindowAtEnd || Filter->bGroupDuplicates))
+        {
+            MakeDirty();
+        }
+        return true;
+    }
+
+    if (TextLayout)
+    {
+        // If we were previously empty, then we'd have inserted a dummy empty line into the document
+        // We need to remove this line now as it would cause the message indices to get out-of-sync with the line numbers, which would break auto-scrolling
+        const bool bWasEmpty = GetNumFilteredMessages() == 0;
+        if (bWasEmpty)
+        {
+            TextLayout->ClearLines();
+        }
+
+        // If we've already been given a text layout, then append these new messages rather than force a refresh of the entire document
+        AppendMessagesToTextLayout(MaxNumLines);
+
+        if (TextLayout->GetLineModels().Num() == 0) {
+            TextLayout->AddEmptyRun();
+        }
+    }
+    else
+    {
+        MarkMessagesCacheAsDirty();
+        MakeDirty();
+    }
+
+    return true;
+}
+
+int32 FOutputLogTextLayoutMarshaller::CreateRepeatedLastMessageLines(int32 MaxNumLines, TArray<FTextLayout::FNewLineData>& OutLines)
+{
+    if (LayoutEndSequence <= GetViewStartSequence())
+    {
+        return 0;
+    }
+
+    const FLogMessage& LastMessage = Messages->GetBySequence(LayoutEndSequence - 1);
+    const int32 NumNewRepetitions = LastMessage.Count - LayoutLastMessageCount;
+    if (NumNewRepetitions <= 0)
+    {
+        return 0;
+    }
+
+    if (!IsMessageAllowed(LayoutEndSequence - 1))
+    {
+        LayoutLastMessageCount = LastMessage.Count;
+        return 0;
+    }
+
+    if (Filter->bCollapsedMode) {
+        // Replace the line with one showing the new counter
+        LayoutLastMessageCount = LastMessage.Count;
+        TextLayout->RemoveLine(TextLayout->GetLineModels().Num() - 1);
+        CachedNumMessages--;
+        CreateMessageLines(LayoutEndSequence - 1, 1, OutLines);
+        return 1;
+    }
+
+    // The repetitions that do not fit into this frame are added in the next ones
+    const int32 NumLines = FMath::Min(NumNewRepetitions, MaxNumLines);
+    LayoutLastMessageCount += NumLines;
+    CreateMessageLines(LayoutEndSequence - 1, NumLines, OutLines);
+    return NumLines;
+}
+
+void FOutputLogTextLayoutMarshaller::OnMessagesEvicted(int32 NumEvicted)
+{
+    if (Filter->bGroupDuplicates && Filter->bSortGroupsByCount)
+    {
+        if (bVirtualized ? bRowsDirty : !TextLayout)
+        {
+            // All rows are built again anyway
+            MarkMessagesCacheAsDirty();
+            return;
         }
-        Messages.Append(NewMessages);
 
-        if (TextLayout)
+        if (RemoveEvictedGroups(Messages->GetFirstSequence() + NumEvicted))
         {
-            // If we were previously empty, then we'd have inserted a dummy empty line into the document
-            // We need to remove this line now as it would cause the message indices to get out-of-sync with the line numbers, which would break auto-scrolling
-            if (bWasEmpty)
+            SortRowsByCount();
+            if (bVirtualized)
+            {
+                CachedNumMessages = GetNumRows();
+                MakeDirty();
+            }
+            else
             {
+                TArray<FTextLayout::FNewLineData> LinesToAdd;
+                CreateRowLines(0, Rows.Num(), LinesToAdd);
                 TextLayout->ClearLines();
+                TextLayout->AddLines(LinesToAdd);
+                CachedNumMessages = Rows.Num();
             }
+        }
+        return;
+    }
 
-            // If we've already been given a text layout, then append these new messages rather than force a refresh of the entire document
-            AppendMessagesToTextLayout(NewMessages);
-
-            if (TextLayout->GetLineModels().Num() == 0) {
-                TextLayout->AddEmptyRun();
+    if (bVirtualized)
+    {
+        const uint64 EvictedEndSequence = Messages->GetFirstSequence() + NumEvicted;
+        while (FirstRow < Rows.Num() && Rows[FirstRow] < EvictedEndSequence)
+        {
+            if (Filter->bGroupDuplicates && !bRowsDirty && Rows[FirstRow] >= Messages->GetFirstSequence())
+            {
+                // The row shows the newest message of its group, so all messages of the group are gone
+                Groups.Remove(GetGroupKey(Messages->GetBySequence(Rows[FirstRow])));
             }
+            FirstRow++;
         }
-        else
+        if (WindowStart < FirstRow)
         {
-            MarkMessagesCacheAsDirty();
+            WindowStart = FirstRow;
             MakeDirty();
         }
 
-        return true;
+        // Drop the evicted rows once they make up half of the array, so removing them stays amortized O(1)
+        if (FirstRow >= VirtualViewDefs::MinRowsToCompact && FirstRow * 2 >= Rows.Num())
+        {
+            Rows.RemoveAt(0, FirstRow, false);
+            WindowStart -= FirstRow;
+            FirstRow = 0;
+        }
+        CachedNumMessages = GetNumRows();
+        return;
+    }
+
+    if (!TextLayout)
+    {
+        MarkMessagesCacheAsDirty();
+        return;
+    }
+
+    if (Filter->bGroupDuplicates)
+    {
+        // Every row is a line, the rows whose message is evicted are at the start and take all messages of their group with them
+        const uint64 EvictedEndSequence = Messages->GetFirstSequence() + NumEvicted;
+        int32 NumEvictedRows = 0;
+        for (; NumEvictedRows < Rows.Num() && Rows[NumEvictedRows] < EvictedEndSequence; NumEvictedRows++)
+        {
+            if (Rows[NumEvictedRows] >= Messages->GetFirstSequence())
+            {
+                Groups.Remove(GetGroupKey(Messages->GetBySequence(Rows[NumEvictedRows])));
+            }
+        }
+        Rows.RemoveAt(0, NumEvictedRows, false);
+        TextLayout->RemoveLinesFromStart(NumEvictedRows);
+        CachedNumMessages = Rows.Num();
+        return;
+    }
+
+    // Only messages that already made it into the layout have lines that need to be dropped
+    const uint64 EvictedEndSequence = FMath::Min(Messages->GetFirstSequence() + NumEvicted, LayoutEndSequence);
+    int32 NumEvictedLines = 0;
+    for (uint64 Sequence = GetViewStartSequence(); Sequence < EvictedEndSequence; Sequence++)
+    {
+        NumEvictedLines += GetNumMessageLines(Sequence);
+    }
+    TextLayout->RemoveLinesFromStart(NumEvictedLines);
+    CachedNumMessages -= NumEvictedLines;
+}
+
+int32 FOutputLogTextLayoutMarshaller::GetNumMessageLines(uint64 Sequence) const
+{
+    if (!IsMessageAllowed(Sequence))
+    {
+        return 0;
+    }
+    if (Filter->bCollapsedMode)
+    {
+        return 1;
+    }
+    // The last message in the layout might have been repeated since it was added
+    return Sequence + 1 == LayoutEndSequence ? LayoutLastMessageCount : Messages->GetBySequence(Sequence).Count;
+}
+
+bool FOutputLogTextLayoutMarshaller::IsMessageAllowed(uint64 Sequence) const
+{
+    bool bVisible;
+    if (!FilterResults.Find(Sequence, bVisible))
+    {
+        bVisible = Filter->IsMessageAllowed(Messages->GetBySequence(Sequence));
+        FilterResults.Add(Sequence, bVisible);
+    }
+    return bVisible;
+}
+
+uint64 FOutputLogTextLayoutMarshaller::GetViewStartSequence() const
+{
+    return FMath::Max(ClearedSequence, Messages->GetFirstSequence());
+}
+
+void FOutputLogTextLayoutMarshaller::FilterPendingMessages()
+{
+    const uint64 ViewStartSequence = GetViewStartSequence();
+    FilteredEndSequence = FMath::Max(FilteredEndSequence, ViewStartSequence);
+
+    if (Search.IsValid())
+    {
+        FilteredEndSequence = FMath::Max(FilteredEndSequence, Search->CollectResults(FilterResults, ViewStartSequence));
+        if (!Search->IsFinished())
+        {
+            // The few messages logged since the search started are checked inline meanwhile, so they are shown right after its results.
+            // If more have piled up, another search checks them once this one is finished.
+            const uint64 EndSequence = Messages->GetEndSequence();
+            if (EndSequence - Search->GetEndSequence() <= FilterDefs::MaxMessagesFilteredInline)
+            {
+                for (uint64 Sequence = FMath::Max(Search->GetEndSequence(), ViewStartSequence); Sequence < EndSequence; Sequence++)
+                {
+                    IsMessageAllowed(Sequence);
+                }
+            }
+            return;
+        }
+        Search.Reset();
+    }
+
+    const uint64 EndSequence = Messages->GetEndSequence();
+    if (EndSequence - FilteredEndSequence > FilterDefs::MaxMessagesFilteredInline)
+    {
+        Search = MakeUnique<FLogFilterSearch>(*Messages, *Filter, FilterResults, FilteredEndSequence, EndSequence);
+        return;
+    }
+
+    // Starting a search for the few messages logged since the last frame would only delay them by another frame
+    for (; FilteredEndSequence < EndSequence; FilteredEndSequence++)
+    {
+        IsMessageAllowed(FilteredEndSequence);
     }
+}
 
-    return false;
+bool FOutputLogTextLayoutMarshaller::IsSearching() const
+{
+    return Search.IsValid();
 }
 
-void FOutputLogTextLayoutMarshaller::AppendMessageToTextLayout(const TSharedPtr<FLogMessage>& InMessage)
+int32 FOutputLogTextLayoutMarshaller::GetNumSearchMatches() const
 {
-    TArray<TSharedPtr<FLogMessage>> MessagesList;
-    MessagesList.Add(InMessage);
-    AppendMessagesToTextLayout(MessagesList);
+    return Search.IsValid() ? Search->GetNumMatches() : 0;
 }
 
 struct RichTextHelper {
@@ -665,9 +947,11 @@ struct RichTextHelper {
         bpEditor.JumpToHyperlink(Graph, false);
     }
 
-    static void OpenBlueprint(const FSlateHyperlinkRun::FMetadata& Metadata, UBlueprint* Blueprint, UEdGraph* Graph)
+    static void OpenBlueprint(const FSlateHyperlinkRun::FMetadata& Metadata, TWeakObjectPtr<UBlueprint> WeakBlueprint, TWeakObjectPtr<UEdGraph> WeakGraph)
     {
-        if (Blueprint && Blueprint->IsValidLowLevel()) {
+        UBlueprint* Blueprint = WeakBlueprint.Get();
+        UEdGraph* Graph = WeakGraph.Get();
+        if (Blueprint) {
 
             // check to see if the blueprint is already opened in one of the editors
             UAssetEditorSubsystem* EditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
@@ -676,7 +960,7 @@ struct RichTextHelper {
                 FBlueprintEditor* bpEditor = static_cast<FBlueprintEditor*>(editor);
                 if (bpEditor && bpEditor->GetBlueprintObj() == Blueprint) {
                     bpEditor->BringToolkitToFront();
-                    if (Graph && Graph->IsValidLowLevel()) {
+                    if (Graph) {
                         JumpToGraph(*bpEditor, Graph);
                     }
                 }
@@ -686,7 +970,7 @@ struct RichTextHelper {
             // open a new editor
             FBlueprintEditorModule& BlueprintEditorModule = FModuleManager::LoadModuleChecked<FBlueprintEditorModule>("Kismet");
             TSharedRef<IBlueprintEditor> NewKismetEditor = BlueprintEditorModule.CreateBlueprintEditor(EToolkitMode::Standalone, TSharedPtr<IToolkitHost>(), Blueprint);
-            if (Graph && Graph->IsValidLowLevel()) {
+            if (Graph) {
                 JumpToGraph(NewKismetEditor.Get(), Graph);
             }
         }
@@ -695,6 +979,19 @@ struct RichTextHelper {
         }
     }
 
+    static void ToggleGroup(const FSlateHyperlinkRun::FMetadata& Metadata, TWeakPtr<FOutputLogTextLayoutMarshaller> WeakMarshaller, uint64 GroupKey)
+    {
+        TSharedPtr<FOutputLogTextLayoutMarshaller> Marshaller = WeakMarshaller.Pin();
+        if (Marshaller.IsValid()) {
+            Marshaller->ToggleGroupExpansion(GroupKey);
+        }
+    }
+
+    static FText GetToggleGroupTooltip(const FSlateHyperlinkRun::FMetadata& Metadata)
+    {
+        return LOCTEXT("ToggleGroup_Tooltip", "Shows or hides the messages of this group");
+    }
+
     static void OpenUrl(const FSlateHyperlinkRun::FMetadata& Metadata)
     {
         const FString* url = Metadata.Find(TEXT("href"));
@@ -716,213 +1013,760 @@ struct RichTextHelper {
     }
 };
 
-void FOutputLogTextLayoutMarshaller::AppendMessagesToTextLayout(const TArray<TSharedPtr<FLogMessage>>& InMessages)
+void FOutputLogTextLayoutMarshaller::AppendMessagesToTextLayout(int32 MaxNumLines)
 {
     TArray<FTextLayout::FNewLineData> LinesToAdd;
-    LinesToAdd.Reserve(InMessages.Num());
-    TArray<UBlueprint*> blueprints;
-    for (TObjectIterator<UBlueprint> Itr; Itr; ++Itr)
+
+    if (Filter->bGroupDuplicates)
     {
-        UBlueprint* bp = *Itr;
-        if (bp->GeneratedClass) {
-            blueprints.Add(bp);
+        // Every row is a line, so the lines of the changed groups move to the end as well
+        TArray<int32> RemovedRows;
+        const int32 NumNewRows = AppendMessagesToGroups(MaxNumLines, RemovedRows);
+        if (!Filter->bSortGroupsByCount)
+        {
+            TextLayout->RemoveLines(RemovedRows);
+            CreateRowLines(Rows.Num() - NumNewRows, Rows.Num(), LinesToAdd);
+        }
+        else if (NumNewRows > 0)
+        {
+            // The rows have been sorted again, so all lines are replaced
+            TextLayout->ClearLines();
+            CreateRowLines(0, Rows.Num(), LinesToAdd);
+        }
+        if (LinesToAdd.Num() > 0)
+        {
+            TextLayout->AddLines(LinesToAdd);
         }
+        CachedNumMessages = Rows.Num();
+        return;
     }
 
-    for (const auto& CurrentMessage : InMessages)
+    // The last message in the layout might have been repeated in the meantime
+    int32 NumAdded = CreateRepeatedLastMessageLines(MaxNumLines, LinesToAdd);
+
+    // Messages that were evicted before they could be added to the layout are skipped.
+    // Only messages that have already been checked by FilterPendingMessages are added, so skipping a hidden message is a bit test.
+    const uint64 StartSequence = FMath::Max(LayoutEndSequence, GetViewStartSequence());
+    const uint64 EndSequence = FilteredEndSequence;
+    LinesToAdd.Reserve(LinesToAdd.Num() + (int32)FMath::Min<uint64>(EndSequence - FMath::Min(StartSequence, EndSequence), MaxNumLines));
+
+    int32 LastMessageCount = 0;
+    uint64 Sequence = StartSequence;
+    for (; Sequence < EndSequence && NumAdded < MaxNumLines; Sequence++)
     {
-        if (!Filter->IsMessageAllowed(CurrentMessage))
+        const FLogMessage& CurrentMessage = Messages->GetBySequence(Sequence);
+        LastMessageCount = CurrentMessage.Count;
+        if (!IsMessageAllowed(Sequence))
         {
             continue;
         }
-        MarkMessagesCacheAsDirty();
 
-        auto StyleSettings = GetDefault<ULogDisplaySettings>();
-        TArray<TSharedRef<IRun>> Runs;
-        TSharedRef<FString> LineText = CurrentMessage->Message;
-        const FTextBlockStyle& MessageTextStyle = GetStyle(CurrentMessage, StyleSettings);
-        int32 startOffset = 0;
-        if (CurrentMessage->Count > 1) {
-            FString* newLine = new FString("{");
-            newLine->AppendInt(CurrentMessage->Count);
-            newLine->Append("} ");
-            startOffset = newLine->Len();
-            newLine->Append(*LineText);
-            LineText = MakeShareable(newLine);
-            const FTextBlockStyle& CountTextStyle = FTextBlockStyle(MessageTextStyle).SetColorAndOpacity(FSlateColor(StyleSettings->CollapsedLineCounterColor));
-            TSharedRef<FSlateTextRun> textRun = FSlateTextRun::Create(FRunInfo(), LineText, CountTextStyle, FTextRange(0, startOffset));
-            Runs.Add(textRun);
+        // A message repeated more often than fits into the frame gets the rest of its lines like a repeated last message
+        const int32 NumLines = Filter->bCollapsedMode ? 1 : FMath::Min(CurrentMessage.Count, MaxNumLines - NumAdded);
+        CreateMessageLines(Sequence, NumLines, LinesToAdd);
+        NumAdded += NumLines;
+        if (!Filter->bCollapsedMode)
+        {
+            LastMessageCount = NumLines;
         }
+    }
 
-        FHyperlinkStyle linkStyle = FEditorStyle::Get().GetWidgetStyle<FHyperlinkStyle>(FName(TEXT("NavigationHyperlink")));
-        linkStyle.SetTextStyle(MessageTextStyle);
+    if (Sequence > StartSequence)
+    {
+        LayoutEndSequence = Sequence;
+        LayoutLastMessageCount = LastMessageCount;
+    }
 
-        TSet<FTextRange> foundLinkRanges;
-        map<int32, TSharedRef<FSlateHyperlinkRun>> hyperlinkRuns;
-        if (StyleSettings->bParseBlueprintLinks) {
-            CreateBlueprintHyperlinks(blueprints, foundLinkRanges, LineText, linkStyle, hyperlinkRuns);
-        }
-        if (StyleSettings->bParseFilePaths) {
-            CreateFilepathHyperlinks(LineText, foundLinkRanges, linkStyle, hyperlinkRuns);
-        }
-        if (StyleSettings->bParseHyperlinks) {
-            CreateUrlHyperlinks(LineText, foundLinkRanges, linkStyle, hyperlinkRuns);
-        }
+    if (LinesToAdd.Num() > 0)
+    {
+        CachedNumMessages += LinesToAdd.Num();
+        TextLayout->AddLines(LinesToAdd);
+    }
+}
 
-        if (hyperlinkRuns.empty()) {
-            Runs.Add(FSlateTextRun::Create(FRunInfo(), LineText, MessageTextStyle, FTextRange(startOffset, LineText->Len())));
+bool FOutputLogTextLayoutMarshaller::AppendMessagesToRows(int32 MaxNumLines)
+{
+    if (Filter->bGroupDuplicates)
+    {
+        TArray<int32> RemovedRows;
+        const int32 NumNewRows = AppendMessagesToGroups(MaxNumLines, RemovedRows);
+
+        // Keep showing the same rows, unless the window is at the end
+        int32 NumRemovedBeforeWindow = 0;
+        while (NumRemovedBeforeWindow < RemovedRows.Num() && RemovedRows[NumRemovedBeforeWindow] < WindowStart)
+        {
+            NumRemovedBeforeWindow++;
         }
-        else {
-            int32 lastIndex = startOffset;
-            for (auto run : hyperlinkRuns) {
-                if (lastIndex < run.first) {
-                    TSharedRef<FSlateTextRun> textRun = FSlateTextRun::Create(FRunInfo(), LineText, MessageTextStyle, FTextRange(lastIndex, run.first));
-                    Runs.Add(textRun);
+        WindowStart -= NumRemovedBeforeWindow;
+
+        CachedNumMessages = GetNumRows();
+        return NumNewRows > 0 || RemovedRows.Num() > 0;
+    }
+
+    const int32 OldNumRows = Rows.Num();
+    bool bLastRowChanged = false;
+
+    // The last message might have been repeated in the meantime
+    if (LayoutEndSequence > GetViewStartSequence())
+    {
+        const FLogMessage& LastMessage = Messages->GetBySequence(LayoutEndSequence - 1);
+        const int32 NumNewRepetitions = LastMessage.Count - LayoutLastMessageCount;
+        if (NumNewRepetitions > 0)
+        {
+            LayoutLastMessageCount = LastMessage.Count;
+            if (IsMessageAllowed(LayoutEndSequence - 1))
+            {
+                if (Filter->bCollapsedMode)
+                {
+                    // The row stays, only its counter changes
+                    bLastRowChanged = true;
+                }
+                else
+                {
+                    for (int32 Repetition = 0; Repetition < NumNewRepetitions; Repetition++)
+                    {
+                        Rows.Add(LayoutEndSequence - 1);
+                    }
                 }
-                Runs.Add(run.second);
-                lastIndex = run.second->GetTextRange().EndIndex;
-            }
-            if (lastIndex < LineText->Len()) {
-                TSharedRef<FSlateTextRun> textRun = FSlateTextRun::Create(FRunInfo(), LineText, MessageTextStyle, FTextRange(lastIndex, LineText->Len()));
-                Runs.Add(textRun);
             }
         }
-
-        LinesToAdd.Emplace(MoveTemp(LineText), MoveTemp(Runs));
     }
 
-    TextLayout->AddLines(LinesToAdd);
-}
-
-void FOutputLogTextLayoutMarshaller::CreateUrlHyperlinks(TSharedRef<FString> LineText, TSet<FTextRange> &foundLinkRanges, FHyperlinkStyle linkStyle, map<int32, TSharedRef<FSlateHyperlinkRun>> &hyperlinkRuns) const
-{
-    FRegexMatcher urlMatcher(UrlPattern, *LineText);
-    while (urlMatcher.FindNext()) {
-        int32 matchStart = urlMatcher.GetMatchBeginning();
-        FTextRange newRange(matchStart, urlMatcher.GetMatchEnding());
-        if (overlapping(newRange, foundLinkRanges)) {
+    // Only messages that have already been checked by FilterPendingMessages get rows
+    const uint64 StartSequence = FMath::Max(LayoutEndSequence, GetViewStartSequence());
+    const uint64 EndSequence = FilteredEndSequence;
+    int32 NumAdded = 0;
+    uint64 Sequence = StartSequence;
+    for (; Sequence < EndSequence && NumAdded < MaxNumLines; Sequence++)
+    {
+        if (!IsMessageAllowed(Sequence))
+        {
             continue;
         }
+        const int32 NumLines = Filter->bCollapsedMode ? 1 : Messages->GetBySequence(Sequence).Count;
+        for (int32 Line = 0; Line < NumLines; Line++)
+        {
+            Rows.Add(Sequence);
+        }
+        NumAdded += NumLines;
+    }
 
-        FRunInfo RunInfo(TEXT("a"));
-        RunInfo.MetaData.Add(TEXT("href"), urlMatcher.GetCaptureGroup(0));
-
-        FSlateHyperlinkRun::FOnClick OnHyperlinkClicked = FSlateHyperlinkRun::FOnClick::CreateStatic(&RichTextHelper::OpenUrl);
-        TSharedRef<FSlateHyperlinkRun> HyperlinkRun = FSlateHyperlinkRun::Create(
-            RunInfo,
-            LineText,
-            linkStyle,
-            OnHyperlinkClicked,
-            FSlateHyperlinkRun::FOnGenerateTooltip(),
-            FSlateHyperlinkRun::FOnGetTooltipText(),
-            newRange
-        );
-        hyperlinkRuns.insert(make_pair(matchStart, HyperlinkRun));
-        foundLinkRanges.Add(newRange);
+    if (Sequence > StartSequence)
+    {
+        LayoutEndSequence = Sequence;
+        LayoutLastMessageCount = Messages->GetBySequence(Sequence - 1).Count;
     }
+
+    CachedNumMessages = GetNumRows();
+    return bLastRowChanged || Rows.Num() != OldNumRows;
 }
 
-void FOutputLogTextLayoutMarshaller::CreateFilepathHyperlinks(TSharedRef<FString> LineText, TSet<FTextRange> &foundLinkRanges, FHyperlinkStyle linkStyle, map<int32, TSharedRef<FSlateHyperlinkRun>> &hyperlinkRuns) const
+void FOutputLogTextLayoutMarshaller::RebuildRows()
 {
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    FRegexMatcher pathMatcher(FilePathPattern, *LineText);
-    while (pathMatcher.FindNext()) {
-        int32 matchStart = pathMatcher.GetMatchBeginning();
-        FTextRange newRange(matchStart, pathMatcher.GetMatchEnding());
-        if (overlapping(newRange, foundLinkRanges)) {
-            continue;
-        }
-
-        FString foundPath = pathMatcher.GetCaptureGroup(0);
-        foundPath.ReplaceInline(ANSI_TO_TCHAR("\""), ANSI_TO_TCHAR(""));
-        foundPath.ReplaceInline(ANSI_TO_TCHAR("'"), ANSI_TO_TCHAR(""));
-        if (!(PlatformFile.DirectoryExists(*foundPath) || PlatformFile.FileExists(*foundPath))) {
-            continue;
-        }
-        bool isSourceFile = foundPath.EndsWith(FString(".cpp")) || foundPath.EndsWith(FString(".h"));
-
-        FRunInfo RunInfo(TEXT("a"));
-        RunInfo.MetaData.Add(TEXT("href"), isSourceFile ? FString("Open source file") : FString("Open file or directory"));
+    Rows.Reset();
+    Groups.Reset();
+    ExpandedMessages.Reset();
+    ExpandedRowsStart = ExpandedRowsEnd = 0;
+    LastGroupSortTime = 0.0;
+    FirstRow = 0;
+    WindowStart = 0;
+    LayoutEndSequence = GetViewStartSequence();
+    LayoutLastMessageCount = 0;
+    bRowsDirty = false;
+    AppendMessagesToRows(MAX_int32);
+}
 
-        FSlateHyperlinkRun::FOnClick OnHyperlinkClicked = FSlateHyperlinkRun::FOnClick::CreateStatic(&RichTextHelper::OpenPath, foundPath, isSourceFile);
-        TSharedRef<FSlateHyperlinkRun> HyperlinkRun = FSlateHyperlinkRun::Create(
-            RunInfo,
-            LineText,
-            linkStyle,
-            OnHyperlinkClicked,
-            FSlateHyperlinkRun::FOnGenerateTooltip(),
-            FSlateHyperlinkRun::FOnGetTooltipText(),
-            newRange
-        );
-        hyperlinkRuns.insert(make_pair(matchStart, HyperlinkRun));
-        foundLinkRanges.Add(newRange);
-    }
-}
-
-void FOutputLogTextLayoutMarshaller::CreateBlueprintHyperlinks(const TArray<UBlueprint*>& blueprints, TSet<FTextRange>& foundLinkRanges, TSharedRef<FString> LineText, FHyperlinkStyle linkStyle, map<int32, TSharedRef<FSlateHyperlinkRun>> &hyperlinkRuns) const
-{
-    for (UBlueprint* bp : blueprints) {
-        auto pathName = bp->GeneratedClass->GetPathName();
-
-        TArray<UEdGraph*> allGraphs;
-        bp->GetAllGraphs(allGraphs);
-        // adds event graph, but only the generated intermediate representation, not the start nodes
-        // allGraphs.Append(bp->EventGraphs);
-        TMap<int32, UEdGraph*> graphIndices;
-        for (auto graph : allGraphs) {
-            auto fullGraphName = pathName + ":" + graph->GetName();
-            int32 index = LineText->Find(fullGraphName);
-            if (index > 0) {
-                graphIndices.Add(index, graph);
-                while (index >= 0 && index < LineText->Len()) {
-                    index = LineText->Find(fullGraphName, ESearchCase::IgnoreCase, ESearchDir::FromStart, index + 1);
-                    if (index > 0) {
-                        graphIndices.Add(index, graph);
-                    }
-                }
-                break;
+int32 FOutputLogTextLayoutMarshaller::AppendMessagesToGroups(int32 MaxNumLines, TArray<int32>& OutRemovedRows)
+{
+    // Groups that changed, in the order they changed first, and the rows they had before
+    TArray<uint64> ChangedKeys;
+    TSet<uint64> ChangedKeySet;
+    TArray<uint64> OldRowSequences;
+    auto AddToGroup = [this, &ChangedKeys, &ChangedKeySet, &OldRowSequences](const FLogMessage& Message, uint64 Sequence, int32 Count) -> uint64
+    {
+        const uint64 Key = GetGroupKey(Message);
+        FLogMessageGroups::FGroup& Group = Groups.FindOrAdd(Key);
+        bool bAlreadyChanged = false;
+        ChangedKeySet.Add(Key, &bAlreadyChanged);
+        if (!bAlreadyChanged)
+        {
+            ChangedKeys.Add(Key);
+            if (Group.Count > 0)
+            {
+                OldRowSequences.Add(Group.LastSequence);
             }
         }
+        Group.LastSequence = Sequence;
+        Group.Count += Count;
+        return Key;
+    };
 
-        TArray<int32> indices;
-        int32 foundIndex = -1;
-        do {
-            foundIndex = LineText->Find(pathName, ESearchCase::IgnoreCase, ESearchDir::FromStart, foundIndex + 1);
-            if (foundIndex > 0) {
-                indices.Add(foundIndex);
-            }
-        } while (foundIndex >= 0 && foundIndex < LineText->Len());
-
-        for (int32 index : indices) {
-            UEdGraph* foundGraph = graphIndices.Contains(index) ? graphIndices[index] : nullptr;
-            int32 graphNameOffset = foundGraph ? foundGraph->GetName().Len() + 1 : 0;
-            FTextRange newRange(index, index + pathName.Len() + graphNameOffset);
-            if (overlapping(newRange, foundLinkRanges)) {
-                continue;
+    // The last message might have been repeated in the meantime
+    if (LayoutEndSequence > GetViewStartSequence())
+    {
+        const FLogMessage& LastMessage = Messages->GetBySequence(LayoutEndSequence - 1);
+        const int32 NumNewRepetitions = LastMessage.Count - LayoutLastMessageCount;
+        if (NumNewRepetitions > 0)
+        {
+            LayoutLastMessageCount = LastMessage.Count;
+            if (IsMessageAllowed(LayoutEndSequence - 1))
+            {
+                AddToGroup(LastMessage, LayoutEndSequence - 1, NumNewRepetitions);
             }
-            FRunInfo RunInfo(TEXT("a"));
-            RunInfo.MetaData.Add(TEXT("href"), FString("Open in Blueprint Editor"));
-
-            FSlateHyperlinkRun::FOnClick OnHyperlinkClicked = FSlateHyperlinkRun::FOnClick::CreateStatic(&RichTextHelper::OpenBlueprint, bp, foundGraph);
-            TSharedRef<FSlateHyperlinkRun> HyperlinkRun = FSlateHyperlinkRun::Create(
-                RunInfo,
-                LineText,
-                linkStyle,
-                OnHyperlinkClicked,
-                FSlateHyperlinkRun::FOnGenerateTooltip(),
-                FSlateHyperlinkRun::FOnGetTooltipText(),
-                newRange
-            );
-            hyperlinkRuns.insert(make_pair(newRange.BeginIndex, HyperlinkRun));
-            foundLinkRanges.Add(newRange);
         }
     }
-}
 
+    // Only messages that have already been checked by FilterPendingMessages are grouped
+    const uint64 StartSequence = FMath::Max(LayoutEndSequence, GetViewStartSequence());
+    const uint64 EndSequence = FilteredEndSequence;
+    int32 NumAdded = 0;
+    uint64 Sequence = StartSequence;
+    for (; Sequence < EndSequence && NumAdded < MaxNumLines; Sequence++)
+    {
+        if (IsMessageAllowed(Sequence))
+        {
+            const FLogMessage& Message = Messages->GetBySequence(Sequence);
+            const uint64 Key = AddToGroup(Message, Sequence, Message.Count);
+            if (Filter->bSortGroupsByCount && ExpandedGroupKey.IsSet() && ExpandedGroupKey.GetValue() == Key)
+            {
+                ExpandedMessages.Add(Sequence);
+            }
+            NumAdded++;
+        }
+    }
+
+    if (Sequence > StartSequence)
+    {
+        LayoutEndSequence = Sequence;
+        LayoutLastMessageCount = Messages->GetBySequence(Sequence - 1).Count;
+    }
+
+    if (Filter->bSortGroupsByCount)
+    {
+        // Any group might have moved. Under steady spam some group changes every frame, and sorting and creating all rows
+        // again that often would stall the view, so the rows are only sorted again once the interval has passed.
+        bGroupSortPending |= ChangedKeys.Num() > 0;
+        if (!IsGroupSortDue())
+        {
+            return 0;
+        }
+        SortRowsByCount();
+        return 1;
+    }
+
+    // The rows are ordered by sequence number, so the old row of a group is found with a binary search
+    for (uint64 OldRowSequence : OldRowSequences)
+    {
+        const int32 Row = Algo::LowerBound(Rows, OldRowSequence);
+        if (Row >= FirstRow && Row < Rows.Num() && Rows[Row] == OldRowSequence)
+        {
+            OutRemovedRows.Add(Row);
+        }
+    }
+    OutRemovedRows.Sort();
+
+    if (OutRemovedRows.Num() > 0)
+    {
+        int32 NumKept = OutRemovedRows[0];
+        for (int32 Row = OutRemovedRows[0], NextRemoved = 0; Row < Rows.Num(); Row++)
+        {
+            if (NextRemoved < OutRemovedRows.Num() && OutRemovedRows[NextRemoved] == Row)
+            {
+                NextRemoved++;
+                continue;
+            }
+            Rows[NumKept++] = Rows[Row];
+        }
+        Rows.SetNum(NumKept, false);
+    }
+
+    TArray<uint64> NewRows;
+    NewRows.Reserve(ChangedKeys.Num());
+    for (uint64 Key : ChangedKeys)
+    {
+        NewRows.Add(Groups.Find(Key)->LastSequence);
+    }
+    NewRows.Sort();
+    Rows.Append(NewRows);
+    return NewRows.Num();
+}
+
+void FOutputLogTextLayoutMarshaller::SortRowsByCount()
+{
+    TArray<FLogMessageGroups::FGroup> SortedGroups;
+    Groups.GetGroups().GenerateValueArray(SortedGroups);
+    SortedGroups.Sort([](const FLogMessageGroups::FGroup& A, const FLogMessageGroups::FGroup& B)
+    {
+        return A.Count != B.Count ? A.Count > B.Count : A.LastSequence > B.LastSequence;
+    });
+
+    const FLogMessageGroups::FGroup* ExpandedGroup = ExpandedGroupKey.IsSet() ? Groups.Find(ExpandedGroupKey.GetValue()) : nullptr;
+    Rows.Reset(SortedGroups.Num() + (ExpandedGroup ? ExpandedMessages.Num() : 0));
+    FirstRow = 0;
+    ExpandedRowsStart = ExpandedRowsEnd = 0;
+    OldestGroupSequence = MAX_uint64;
+    bGroupSortPending = false;
+    LastGroupSortTime = FPlatformTime::Seconds();
+    for (const FLogMessageGroups::FGroup& Group : SortedGroups)
+    {
+        Rows.Add(Group.LastSequence);
+        OldestGroupSequence = FMath::Min(OldestGroupSequence, Group.LastSequence);
+        if (ExpandedGroup && Group.LastSequence == ExpandedGroup->LastSequence)
+        {
+            ExpandedRowsStart = Rows.Num();
+            Rows.Append(ExpandedMessages);
+            ExpandedRowsEnd = Rows.Num();
+        }
+    }
+}
+
+bool FOutputLogTextLayoutMarshaller::IsGroupSortDue() const
+{
+    return bGroupSortPending && FPlatformTime::Seconds() - LastGroupSortTime >= GroupViewDefs::SortInterval;
+}
+
+bool FOutputLogTextLayoutMarshaller::RemoveEvictedGroups(uint64 EvictedEndSequence)
+{
+    bool bRowsChanged = false;
+
+    // The newest messages of the groups are usually not evicted, so the rows only have to be checked once the oldest one is
+    if (EvictedEndSequence > OldestGroupSequence)
+    {
+        for (int32 Row = 0; Row < Rows.Num(); Row++)
+        {
+            if ((Row < ExpandedRowsStart || Row >= ExpandedRowsEnd) && Rows[Row] < EvictedEndSequence)
+            {
+                // The row showed the newest message of its group when the rows were sorted, unless the group has newer messages
+                // since then all messages of the group are gone. Either way the row has to go.
+                const uint64 Key = GetGroupKey(Messages->GetBySequence(Rows[Row]));
+                const FLogMessageGroups::FGroup* Group = Groups.Find(Key);
+                if (Group && Group->LastSequence < EvictedEndSequence)
+                {
+                    Groups.Remove(Key);
+                    if (ExpandedGroupKey.IsSet() && ExpandedGroupKey.GetValue() == Key)
+                    {
+                        ExpandedGroupKey.Reset();
+                        ExpandedMessages.Reset();
+                    }
+                }
+                bRowsChanged = true;
+            }
+        }
+    }
+
+    int32 NumEvictedMessages = 0;
+    while (NumEvictedMessages < ExpandedMessages.Num() && ExpandedMessages[NumEvictedMessages] < EvictedEndSequence)
+    {
+        NumEvictedMessages++;
+    }
+    ExpandedMessages.RemoveAt(0, NumEvictedMessages, false);
+    return bRowsChanged || NumEvictedMessages > 0;
+}
+
+void FOutputLogTextLayoutMarshaller::ToggleGroupExpansion(uint64 GroupKey)
+{
+    if (ExpandedGroupKey.IsSet() && ExpandedGroupKey.GetValue() == GroupKey)
+    {
+        ExpandedGroupKey.Reset();
+    }
+    else
+    {
+        ExpandedGroupKey = GroupKey;
+    }
+
+    if (bVirtualized && !bRowsDirty)
+    {
+        // Only the rows are sorted again, so the window keeps its position
+        ExpandedMessages.Reset();
+        for (uint64 Sequence = GetViewStartSequence(); ExpandedGroupKey.IsSet() && Sequence < LayoutEndSequence; Sequence++)
+        {
+            if (IsMessageAllowed(Sequence) && GetGroupKey(Messages->GetBySequence(Sequence)) == GroupKey)
+            {
+                ExpandedMessages.Add(Sequence);
+            }
+        }
+        SortRowsByCount();
+        CachedNumMessages = GetNumRows();
+    }
+
+    // Without virtualization all lines are created again, which collects the messages of the group as well
+    MakeDirty();
+}
+
+void FOutputLogTextLayoutMarshaller::CreateRowLines(int32 StartRow, int32 EndRow, TArray<FTextLayout::FNewLineData>& OutLines) const
+{
+    OutLines.Reserve(OutLines.Num() + EndRow - StartRow);
+    for (int32 Row = StartRow; Row < EndRow; Row++)
+    {
+        const bool bGroupMessage = Row >= ExpandedRowsStart && Row < ExpandedRowsEnd;
+        CreateMessageLines(Rows[Row], 1, OutLines, bGroupMessage);
+    }
+}
+
+void FOutputLogTextLayoutMarshaller::AddWindowLines()
+{
+    WindowStart = FMath::Clamp(WindowStart, FirstRow, FMath::Max(FirstRow, Rows.Num() - WindowSize));
+    const int32 WindowEnd = FMath::Min(WindowStart + WindowSize, Rows.Num());
+
+    TArray<FTextLayout::FNewLineData> LinesToAdd;
+    CreateRowLines(WindowStart, WindowEnd, LinesToAdd);
+
+    if (LinesToAdd.Num() > 0)
+    {
+        TextLayout->AddLines(LinesToAdd);
+    }
+}
+
+void FOutputLogTextLayoutMarshaller::SetWindow(int32 InWindowStart, int32 InWindowSize)
+{
+    InWindowSize = FMath::Max(InWindowSize, 1);
+    const int32 NewWindowStart = FMath::Clamp(FirstRow + InWindowStart, FirstRow, FMath::Max(FirstRow, Rows.Num() - InWindowSize));
+    if (NewWindowStart != WindowStart || InWindowSize != WindowSize)
+    {
+        WindowStart = NewWindowStart;
+        WindowSize = InWindowSize;
+        MakeDirty();
+    }
+}
+
+FTextLocation FOutputLogTextLayoutMarshaller::GetLayoutEnd() const
+{
+    if (!TextLayout || TextLayout->GetLineModels().Num() == 0) {
+        return FTextLocation(0);
+    }
+    const int32 LastLine = TextLayout->GetLineModels().Num() - 1;
+    return FTextLocation(LastLine, TextLayout->GetLineModels()[LastLine].Text->Len());
+}
 
-FTextBlockStyle FOutputLogTextLayoutMarshaller::GetStyle(const TSharedPtr<FLogMessage>& Message, const ULogDisplaySettings* StyleSettings) const
+void FOutputLogTextLayoutMarshaller::CreateMessageLines(uint64 Sequence, int32 NumRepetitions, TArray<FTextLayout::FNewLineData>& OutLines, bool bGroupMessage) const
 {
-    auto style = FTextBlockStyle(FEditorStyle::Get().GetWidgetStyle<FTextBlockStyle>(Message->Style));
+    const FLogMessage& CurrentMessage = Messages->GetBySequence(Sequence);
+    const FMessageStyle& MessageStyle = GetStyle(CurrentMessage);
+    const FTextBlockStyle& MessageTextStyle = MessageStyle.TextStyle;
+    const FHyperlinkStyle& linkStyle = MessageStyle.LinkStyle;
+
+    // The layout needs the text as a shared string, the repetitions of the message can share it
+    const TSharedRef<FString> MessageText = MakeShareable(new FString(CurrentMessage.Len, CurrentMessage.Text));
+
+    // A group is shown in place of its newest message, with the number of messages in the group and when the newest one was logged.
+    // The messages of an expanded group are listed below it like in collapsed mode.
+    int32 DisplayedCount = Filter->bCollapsedMode || bGroupMessage ? CurrentMessage.Count : 1;
+    uint64 GroupKey = 0;
+    if (Filter->bGroupDuplicates && !bGroupMessage) {
+        GroupKey = GetGroupKey(CurrentMessage);
+        const FLogMessageGroups::FGroup* Group = Groups.Find(GroupKey);
+        DisplayedCount = Group ? Group->Count : CurrentMessage.Count;
+    }
+    const bool bCanExpand = Filter->bGroupDuplicates && Filter->bSortGroupsByCount && !bGroupMessage && DisplayedCount > 1;
+
+    // Without virtualization most lines are never scrolled into view, their links are added later by UpdatePendingLinks
+    auto StyleSettings = GetDefault<ULogDisplaySettings>();
+    const bool bParseLinks = StyleSettings->bParseBlueprintLinks || StyleSettings->bParseFilePaths || StyleSettings->bParseHyperlinks;
+    const bool bDeferLinks = !bVirtualized && bParseLinks;
+
+    // Every line needs its own runs, so repeated lines are created from scratch as well
+    for (int32 Repetition = 0; Repetition < NumRepetitions; Repetition++)
+    {
+        TArray<TSharedRef<IRun>> Runs;
+        TSharedRef<FString> LineText = MessageText;
+        int32 startOffset = 0;
+        if (DisplayedCount > 1 || bGroupMessage) {
+            FString* newLine = new FString(bGroupMessage ? GroupViewDefs::MessageIndent : TEXT(""));
+            const int32 countOffset = newLine->Len();
+            if (DisplayedCount > 1) {
+                newLine->Append("{");
+                newLine->AppendInt(DisplayedCount);
+                if (Filter->bGroupDuplicates && !bGroupMessage) {
+                    newLine->Append(FString::Printf(TEXT(", last %.2fs"), CurrentMessage.Time));
+                }
+                newLine->Append("} ");
+            }
+            startOffset = newLine->Len();
+            newLine->Append(*LineText);
+            LineText = MakeShareable(newLine);
+            if (countOffset > 0) {
+                Runs.Add(FSlateTextRun::Create(FRunInfo(), LineText, MessageTextStyle, FTextRange(0, countOffset)));
+            }
+            if (startOffset > countOffset) {
+                const FTextRange countRange(countOffset, startOffset);
+                if (bCanExpand) {
+                    // Clicking the counter lists the messages of the group
+                    FSlateHyperlinkRun::FOnClick OnHyperlinkClicked = FSlateHyperlinkRun::FOnClick::CreateStatic(&RichTextHelper::ToggleGroup, WeakThis, GroupKey);
+                    Runs.Add(FSlateHyperlinkRun::Create(
+                        FRunInfo(),
+                        LineText,
+                        linkStyle,
+                        OnHyperlinkClicked,
+                        FSlateHyperlinkRun::FOnGenerateTooltip(),
+                        FSlateHyperlinkRun::FOnGetTooltipText::CreateStatic(&RichTextHelper::GetToggleGroupTooltip),
+                        countRange
+                    ));
+                }
+                else {
+                    Runs.Add(FSlateTextRun::Create(FRunInfo(), LineText, MessageStyle.CountStyle, countRange));
+                }
+            }
+        }
+
+        if (bDeferLinks) {
+            Runs.Add(FSlateTextRun::Create(FRunInfo(), LineText, MessageTextStyle, FTextRange(startOffset, LineText->Len())));
+            FPendingLinkLine& PendingLine = PendingLinkLines.AddDefaulted_GetRef();
+            PendingLine.LineText = LineText;
+            PendingLine.Sequence = Sequence;
+            PendingLine.TextOffset = startOffset;
+        }
+        else {
+            CreateMessageTextRuns(Sequence, MessageStyle, LineText, startOffset, Runs);
+        }
+
+        OutLines.Emplace(MoveTemp(LineText), MoveTemp(Runs));
+    }
+}
+
+bool FOutputLogTextLayoutMarshaller::CreateMessageTextRuns(uint64 Sequence, const FMessageStyle& MessageStyle, const TSharedRef<FString>& LineText, int32 TextOffset, TArray<TSharedRef<IRun>>& OutRuns) const
+{
+    auto StyleSettings = GetDefault<ULogDisplaySettings>();
+    const FLogMessage& Message = Messages->GetBySequence(Sequence);
+    const FTextBlockStyle& MessageTextStyle = MessageStyle.TextStyle;
+    const FHyperlinkStyle& linkStyle = MessageStyle.LinkStyle;
+
+    // The kinds of links are searched in order of priority, a link that overlaps one found before is dropped
+    FLineLinks links;
+    if (StyleSettings->bParseBlueprintLinks && BlueprintLinks.IsValid()) {
+        CreateBlueprintHyperlinks(LineText, TextOffset, linkStyle, links);
+    }
+    if (StyleSettings->bParseFilePaths || StyleSettings->bParseHyperlinks) {
+        const FLinkCandidates& Candidates = FindLinkCandidates(Sequence, Message);
+        if (StyleSettings->bParseFilePaths) {
+            CreateFilepathHyperlinks(Sequence, LineText, TextOffset, Candidates, linkStyle, links);
+        }
+        if (StyleSettings->bParseHyperlinks) {
+            CreateUrlHyperlinks(LineText, TextOffset, Candidates, linkStyle, links);
+        }
+    }
+
+    if (links.Num() == 0) {
+        OutRuns.Add(FSlateTextRun::Create(FRunInfo(), LineText, MessageTextStyle, FTextRange(TextOffset, LineText->Len())));
+        return false;
+    }
+
+    int32 lastIndex = TextOffset;
+    for (const TSharedRef<FSlateHyperlinkRun>& run : links) {
+        const FTextRange runRange = run->GetTextRange();
+        if (lastIndex < runRange.BeginIndex) {
+            TSharedRef<FSlateTextRun> textRun = FSlateTextRun::Create(FRunInfo(), LineText, MessageTextStyle, FTextRange(lastIndex, runRange.BeginIndex));
+            OutRuns.Add(textRun);
+        }
+        OutRuns.Add(run);
+        lastIndex = runRange.EndIndex;
+    }
+    if (lastIndex < LineText->Len()) {
+        TSharedRef<FSlateTextRun> textRun = FSlateTextRun::Create(FRunInfo(), LineText, MessageTextStyle, FTextRange(lastIndex, LineText->Len()));
+        OutRuns.Add(textRun);
+    }
+    return true;
+}
+
+const FOutputLogTextLayoutMarshaller::FLinkCandidates& FOutputLogTextLayoutMarshaller::FindLinkCandidates(uint64 Sequence, const FLogMessage& Message) const
+{
+    if (const FLinkCandidates* Cached = LinkCandidates.FindAndTouch(Sequence)) {
+        return *Cached;
+    }
+
+    // Most messages contain no trigger for either pattern, the regular expressions only run on the windows around the triggers
+    auto StyleSettings = GetDefault<ULogDisplaySettings>();
+    FLogLinkScanner::FWindows Windows;
+    FLogLinkScanner::FindWindows(Message.Text, Message.Len, StyleSettings->bParseHyperlinks, StyleSettings->bParseFilePaths, Windows);
+
+    FLinkCandidates Candidates;
+    for (const FTextRange& Window : Windows.Paths) {
+        const FString WindowText(Window.Len(), Message.Text + Window.BeginIndex);
+        FRegexMatcher pathMatcher(FilePathPattern, WindowText);
+        while (pathMatcher.FindNext()) {
+            FString foundPath = pathMatcher.GetCaptureGroup(0);
+            foundPath.ReplaceInline(ANSI_TO_TCHAR("\""), ANSI_TO_TCHAR(""));
+            foundPath.ReplaceInline(ANSI_TO_TCHAR("'"), ANSI_TO_TCHAR(""));
+            Candidates.PathRanges.Emplace(Window.BeginIndex + pathMatcher.GetMatchBeginning(), Window.BeginIndex + pathMatcher.GetMatchEnding());
+            Candidates.Paths.Add(MoveTemp(foundPath));
+        }
+    }
+    for (const FTextRange& Window : Windows.Urls) {
+        const FString WindowText(Window.Len(), Message.Text + Window.BeginIndex);
+        FRegexMatcher urlMatcher(UrlPattern, WindowText);
+        while (urlMatcher.FindNext()) {
+            Candidates.UrlRanges.Emplace(Window.BeginIndex + urlMatcher.GetMatchBeginning(), Window.BeginIndex + urlMatcher.GetMatchEnding());
+        }
+    }
+
+    LinkCandidates.Add(Sequence, MoveTemp(Candidates));
+    return *LinkCandidates.Find(Sequence);
+}
+
+void FOutputLogTextLayoutMarshaller::UpdatePendingLinks()
+{
+    if (!TextLayout || PendingLinkLines.Num() == 0) {
+        return;
+    }
+
+    // The newest lines are the ones most likely to be visible, so they get their links first.
+    // Lines keep the order they have been created in, so a single backwards pass over the layout finds almost all of them.
+    // Lines queued again once their file paths have been found can be out of order, the search wraps around for them.
+    const TArray<FTextLayout::FLineModel>& LineModels = TextLayout->GetLineModels();
+    const double EndTime = FPlatformTime::Seconds() + LinkDefs::MaxSecondsPerFrame;
+    int32 LineIndex = LineModels.Num() - 1;
+    int32 NumPending = PendingLinkLines.Num();
+    while (NumPending > 0 && FPlatformTime::Seconds() < EndTime) {
+        const FPendingLinkLine& PendingLine = PendingLinkLines[NumPending - 1];
+        const TSharedPtr<FString> LineText = PendingLine.LineText.Pin();
+        if (!LineText.IsValid() || PendingLine.Sequence < Messages->GetFirstSequence()) {
+            // The line has been removed already
+            NumPending--;
+            continue;
+        }
+
+        const int32 SearchStart = LineIndex;
+        while (LineIndex >= 0 && &LineModels[LineIndex].Text.Get() != LineText.Get()) {
+            LineIndex--;
+        }
+        if (LineIndex < 0) {
+            LineIndex = LineModels.Num() - 1;
+            while (LineIndex > SearchStart && &LineModels[LineIndex].Text.Get() != LineText.Get()) {
+                LineIndex--;
+            }
+            if (LineIndex == SearchStart) {
+                // The line is not in the layout anymore
+                NumPending--;
+                LineIndex = LineModels.Num() - 1;
+                continue;
+            }
+        }
+
+        TArray<TSharedRef<IRun>> Runs;
+        const FMessageStyle& MessageStyle = GetStyle(Messages->GetBySequence(PendingLine.Sequence));
+        if (CreateMessageTextRuns(PendingLine.Sequence, MessageStyle, LineText.ToSharedRef(), PendingLine.TextOffset, Runs)) {
+            TextLayout->ReplaceRuns(LineIndex, PendingLine.TextOffset, Runs);
+        }
+        NumPending--;
+        LineIndex--;
+    }
+    PendingLinkLines.SetNum(NumPending, false);
+}
+
+void FOutputLogTextLayoutMarshaller::CreateUrlHyperlinks(const TSharedRef<FString>& LineText, int32 TextOffset, const FLinkCandidates& Candidates, const FHyperlinkStyle& linkStyle, FLineLinks& links) const
+{
+    for (const FTextRange& urlRange : Candidates.UrlRanges) {
+        int32 matchStart = TextOffset + urlRange.BeginIndex;
+        FTextRange newRange(matchStart, TextOffset + urlRange.EndIndex);
+        const int32 linkIndex = FindLinkIndex(links, newRange);
+        if (linkIndex == INDEX_NONE) {
+            continue;
+        }
+
+        FRunInfo RunInfo(TEXT("a"));
+        RunInfo.MetaData.Add(TEXT("href"), LineText->Mid(newRange.BeginIndex, newRange.Len()));
+
+        FSlateHyperlinkRun::FOnClick OnHyperlinkClicked = FSlateHyperlinkRun::FOnClick::CreateStatic(&RichTextHelper::OpenUrl);
+        TSharedRef<FSlateHyperlinkRun> HyperlinkRun = FSlateHyperlinkRun::Create(
+            RunInfo,
+            LineText,
+            linkStyle,
+            OnHyperlinkClicked,
+            FSlateHyperlinkRun::FOnGenerateTooltip(),
+            FSlateHyperlinkRun::FOnGetTooltipText(),
+            newRange
+        );
+        links.Insert(HyperlinkRun, linkIndex);
+    }
+}
+
+void FOutputLogTextLayoutMarshaller::CreateFilepathHyperlinks(uint64 Sequence, const TSharedRef<FString>& LineText, int32 TextOffset, const FLinkCandidates& Candidates, const FHyperlinkStyle& linkStyle, FLineLinks& links) const
+{
+    for (int32 pathIndex = 0; pathIndex < Candidates.Paths.Num(); pathIndex++) {
+        int32 matchStart = TextOffset + Candidates.PathRanges[pathIndex].BeginIndex;
+        FTextRange newRange(matchStart, TextOffset + Candidates.PathRanges[pathIndex].EndIndex);
+        const int32 linkIndex = FindLinkIndex(links, newRange);
+        if (linkIndex == INDEX_NONE) {
+            continue;
+        }
+
+        const FString& foundPath = Candidates.Paths[pathIndex];
+        const ELogPathState pathState = PathCache.Find(foundPath);
+        if (pathState == ELogPathState::Unknown && NumLinesWaitingForPaths < LinkDefs::MaxLinesWaitingForPaths) {
+            // Unknown paths are checked in the background, the links of the line are created again once the path turns out to exist
+            FPendingLinkLine& WaitingLine = LinesWaitingForPaths.FindOrAdd(foundPath).AddDefaulted_GetRef();
+            WaitingLine.LineText = LineText;
+            WaitingLine.Sequence = Sequence;
+            WaitingLine.TextOffset = TextOffset;
+            NumLinesWaitingForPaths++;
+        }
+        if (pathState != ELogPathState::Exists) {
+            continue;
+        }
+        bool isSourceFile = foundPath.EndsWith(FString(".cpp")) || foundPath.EndsWith(FString(".h"));
+
+        FRunInfo RunInfo(TEXT("a"));
+        RunInfo.MetaData.Add(TEXT("href"), isSourceFile ? FString("Open source file") : FString("Open file or directory"));
+
+        FSlateHyperlinkRun::FOnClick OnHyperlinkClicked = FSlateHyperlinkRun::FOnClick::CreateStatic(&RichTextHelper::OpenPath, foundPath, isSourceFile);
+        TSharedRef<FSlateHyperlinkRun> HyperlinkRun = FSlateHyperlinkRun::Create(
+            RunInfo,
+            LineText,
+            linkStyle,
+            OnHyperlinkClicked,
+            FSlateHyperlinkRun::FOnGenerateTooltip(),
+            FSlateHyperlinkRun::FOnGetTooltipText(),
+            newRange
+        );
+        links.Insert(HyperlinkRun, linkIndex);
+    }
+}
+
+void FOutputLogTextLayoutMarshaller::CreateBlueprintHyperlinks(const TSharedRef<FString>& LineText, int32 TextOffset, const FHyperlinkStyle& linkStyle, FLineLinks& links) const
+{
+    TArray<FBlueprintLink> foundLinks;
+    if (TextOffset > 0) {
+        BlueprintLinks->FindLinks(LineText->Mid(TextOffset), foundLinks);
+    }
+    else {
+        BlueprintLinks->FindLinks(*LineText, foundLinks);
+    }
+
+    for (const FBlueprintLink& link : foundLinks) {
+        FTextRange newRange(TextOffset + link.BeginIndex, TextOffset + link.EndIndex);
+        const int32 linkIndex = FindLinkIndex(links, newRange);
+        if (linkIndex == INDEX_NONE) {
+            continue;
+        }
+        FRunInfo RunInfo(TEXT("a"));
+        RunInfo.MetaData.Add(TEXT("href"), FString("Open in Blueprint Editor"));
+
+        FSlateHyperlinkRun::FOnClick OnHyperlinkClicked = FSlateHyperlinkRun::FOnClick::CreateStatic(&RichTextHelper::OpenBlueprint, link.Blueprint, link.Graph);
+        TSharedRef<FSlateHyperlinkRun> HyperlinkRun = FSlateHyperlinkRun::Create(
+            RunInfo,
+            LineText,
+            linkStyle,
+            OnHyperlinkClicked,
+            FSlateHyperlinkRun::FOnGenerateTooltip(),
+            FSlateHyperlinkRun::FOnGetTooltipText(),
+            newRange
+        );
+        links.Insert(HyperlinkRun, linkIndex);
+    }
+}
+
+
+const FOutputLogTextLayoutMarshaller::FMessageStyle& FOutputLogTextLayoutMarshaller::GetStyle(const FLogMessage& Message) const
+{
+    const int32 CategoryIndex = CategoryMatcher.FindFirstMatch(Message);
+    const TPair<FName, int32> StyleKey(Message.Style, CategoryIndex);
+    if (const FMessageStyle* CachedStyle = StyleCache.Find(StyleKey)) {
+        return *CachedStyle;
+    }
+
+    auto StyleSettings = GetDefault<ULogDisplaySettings>();
+    FMessageStyle& messageStyle = StyleCache.Add(StyleKey);
+    FTextBlockStyle& style = messageStyle.TextStyle;
+    style = FEditorStyle::Get().GetWidgetStyle<FTextBlockStyle>(Message.Style);
     if (StyleSettings->bDisplayTextShadow) {
         style
             .SetShadowColorAndOpacity(StyleSettings->ShadowColor)
@@ -937,52 +1781,81 @@ FTextBlockStyle FOutputLogTextLayoutMarshaller::GetStyle(const TSharedPtr<FLogMe
         style.Font.OutlineSettings.OutlineColor = StyleSettings->OutlineColor;
         style.Font.OutlineSettings.OutlineSize = StyleSettings->OutlineSize;
     }
-    for (const FLogCategorySetting& logCategory : StyleSettings->LogCategories) {
-        if (logCategory.CategorySearchString.IsEmpty()) {
-            continue;
-        }
-        bool isMatch = false;
-        if (logCategory.SearchAsRegex) {
-            try {
-                regex searchPattern(TCHAR_TO_ANSI(*logCategory.CategorySearchString), regex_constants::nosubs | regex_constants::icase);
-                smatch matcher;
-                isMatch = regex_search(Message->CString, matcher, searchPattern);
-            }
-            catch (std::regex_error&) {
-                // just ignore the log category
-            }
-        }
-        else {
-            FTextFilterExpressionEvaluator evaluator(ETextFilterExpressionEvaluatorMode::BasicString);
-            evaluator.SetFilterText(FText::FromString(logCategory.CategorySearchString));
-            isMatch = evaluator.TestTextFilter(FLogFilter_TextFilterExpressionContext(*Message));
+    if (StyleSettings->LogCategories.IsValidIndex(CategoryIndex)) {
+        const FLogCategorySetting& logCategory = StyleSettings->LogCategories[CategoryIndex];
+        style.ColorAndOpacity = FSlateColor(logCategory.TextColor);
+        if (StyleSettings->bDisplayTextShadow) {
+            style.ShadowColorAndOpacity = logCategory.ShadowColor;
         }
+    }
 
-        if (isMatch) {
-            style.ColorAndOpacity = FSlateColor(logCategory.TextColor);
-            if (StyleSettings->bDisplayTextShadow) {
-                style.ShadowColorAndOpacity = logCategory.ShadowColor;
+    messageStyle.CountStyle = FTextBlockStyle(style).SetColorAndOpacity(FSlateColor(StyleSettings->CollapsedLineCounterColor));
+    messageStyle.LinkStyle = FEditorStyle::Get().GetWidgetStyle<FHyperlinkStyle>(FName(TEXT("NavigationHyperlink")));
+    messageStyle.LinkStyle.SetTextStyle(style);
+    return messageStyle;
+}
+
+void FOutputLogTextLayoutMarshaller::UpdateFilePathLinks()
+{
+    TArray<TPair<FString, bool>> FirstResults;
+    const bool bStateChanged = PathCache.CollectResults(FirstResults);
+    if (!GetDefault<ULogDisplaySettings>()->bParseFilePaths)
+    {
+        return;
+    }
+
+    // A file created or deleted since it has been checked is rare, it is not worth remembering the lines of every path for
+    if (bStateChanged)
+    {
+        MakeDirty();
+        return;
+    }
+
+    // Only the lines waiting for the found paths get their links, they are queued like the lines created without links
+    for (const TPair<FString, bool>& Result : FirstResults)
+    {
+        TArray<FPendingLinkLine, TInlineAllocator<1>> WaitingLines;
+        if (LinesWaitingForPaths.RemoveAndCopyValue(Result.Key, WaitingLines))
+        {
+            NumLinesWaitingForPaths -= WaitingLines.Num();
+            if (Result.Value)
+            {
+                PendingLinkLines.Append(WaitingLines);
             }
-            break;
         }
     }
-    return style;
 }
 
-bool FOutputLogTextLayoutMarshaller::overlapping(const FTextRange& testRange, const TSet<FTextRange>& ranges)
+void FOutputLogTextLayoutMarshaller::OnSettingChanged(FName PropertyName)
 {
-    for (FTextRange range : ranges) {
-        if ((range.BeginIndex <= testRange.BeginIndex && range.EndIndex >= testRange.BeginIndex) ||
-            (range.BeginIndex <= testRange.EndIndex   && range.EndIndex >= testRange.EndIndex)) {
-            return true;
-        }
+    CategoryMatcher.Compile(GetDefault<ULogDisplaySettings>()->LogCategories);
+    StyleCache.Reset();
+    LinkCandidates.Empty(LinkDefs::MaxMemoizedMessages);
+
+    // Restyle the lines already shown
+    MakeDirty();
+}
+
+int32 FOutputLogTextLayoutMarshaller::FindLinkIndex(const FLineLinks& links, const FTextRange& range)
+{
+    // The links do not overlap, so only the ones right before and after the insert position can overlap the range
+    const int32 index = Algo::LowerBoundBy(links, range.BeginIndex, [](const TSharedRef<FSlateHyperlinkRun>& link) { return link->GetTextRange().BeginIndex; });
+    if (index > 0 && links[index - 1]->GetTextRange().EndIndex >= range.BeginIndex) {
+        return INDEX_NONE;
     }
-    return false;
+    if (index < links.Num() && links[index]->GetTextRange().BeginIndex <= range.EndIndex) {
+        return INDEX_NONE;
+    }
+    return index;
 }
 
 void FOutputLogTextLayoutMarshaller::ClearMessages()
 {
-    Messages.Empty();
+    // The history is shared with the other log windows, so only this view forgets about the current messages
+    ClearedSequence = Messages->GetEndSequence();
+    Search.Reset();
+    bRowsDirty = bVirtualized;
+    MarkMessagesCacheAsDirty();
     MakeDirty();
 }
 
@@ -994,14 +1867,40 @@ void FOutputLogTextLayoutMarshaller::CountMessages()
         return;
     }
 
+    if (bVirtualized)
+    {
+        // The rows are kept up to date, they only need to be rebuilt if the filter has changed
+        if (bRowsDirty)
+        {
+            RebuildRows();
+        }
+        CachedNumMessages = GetNumRows();
+        bNumMessagesCacheDirty = false;
+        return;
+    }
+
     CachedNumMessages = 0;
 
-    for (const auto& CurrentMessage : Messages)
+    if (Filter->bGroupDuplicates)
     {
-        if (Filter->IsMessageAllowed(CurrentMessage))
+        // One line per distinct message
+        TSet<uint64> Keys;
+        for (uint64 Sequence = GetViewStartSequence(); Sequence < FilteredEndSequence; Sequence++)
         {
-            CachedNumMessages++;
+            if (IsMessageAllowed(Sequence))
+            {
+                Keys.Add(GetGroupKey(Messages->GetBySequence(Sequence)));
+            }
         }
+        CachedNumMessages = Keys.Num();
+        bNumMessagesCacheDirty = false;
+        return;
+    }
+
+    // Messages that have not been checked against the filter yet are not in the view yet either
+    for (uint64 Sequence = GetViewStartSequence(); Sequence < FilteredEndSequence; Sequence++)
+    {
+        CachedNumMessages += GetNumMessageLines(Sequence);
     }
 
     // Cache re-built, remove dirty flag
@@ -1010,17 +1909,11 @@ void FOutputLogTextLayoutMarshaller::CountMessages()
 
 int32 FOutputLogTextLayoutMarshaller::GetNumMessages() const
 {
-    return Messages.Num();
+    return (int32)(Messages->GetEndSequence() - GetViewStartSequence());
 }
 
 int32 FOutputLogTextLayoutMarshaller::GetNumFilteredMessages()
 {
-    // No need to filter the messages if the filter is not set
-    if (!Filter->IsFilterSet())
-    {
-        return GetNumMessages();
-    }
-
     // Re-count messages if filter changed before we refresh
     if (bNumMessagesCacheDirty)
     {
@@ -1037,16 +1930,62 @@ void FOutputLogTextLayoutMarshaller::MarkMessagesCacheAsDirty()
 
 void FOutputLogTextLayoutMarshaller::MarkMessagesFilterAsDirty()
 {
-    for (const auto& CurrentMessage : Messages)
-    {
-        CurrentMessage->filter = UNKNOWN;
-    }
-}
-
-FOutputLogTextLayoutMarshaller::FOutputLogTextLayoutMarshaller(TArray< TSharedPtr<FLogMessage> > InMessages, FLogFilter* InFilter)
-    : Messages(MoveTemp(InMessages))
+    // The running search uses the old filter
+    Search.Reset();
+    FilterResults.Invalidate();
+    FilteredEndSequence = GetViewStartSequence();
+    bRowsDirty = bVirtualized;
+}
+
+void FOutputLogTextLayoutMarshaller::MarkMessagesFilterAsNarrowed()
+{
+    // The running search uses the old filter
+    Search.Reset();
+    FilterResults.InvalidateVisible();
+    FilteredEndSequence = GetViewStartSequence();
+    bRowsDirty = bVirtualized;
+}
+
+void FOutputLogTextLayoutMarshaller::MarkMessagesFilterAsWidened()
+{
+    // The running search uses the old filter
+    Search.Reset();
+    FilterResults.InvalidateHidden();
+    FilteredEndSequence = GetViewStartSequence();
+    bRowsDirty = bVirtualized;
+}
+
+void FOutputLogTextLayoutMarshaller::MarkMessagesGroupingAsDirty()
+{
+    // Collapsing and grouping do not change which messages pass the filter, so the results and the running search are kept
+    Groups.Reset();
+    bRowsDirty = bVirtualized;
+}
+
+FOutputLogTextLayoutMarshaller::FOutputLogTextLayoutMarshaller(const TSharedRef<FLogMessageStore>& InMessages, const TSharedPtr<FBlueprintLinkIndex>& InBlueprintLinks, FLogFilter* InFilter, bool bInVirtualized)
+    : Messages(InMessages)
+    , BlueprintLinks(InBlueprintLinks)
+    , ClearedSequence(0)
+    , LayoutEndSequence(0)
+    , LayoutLastMessageCount(0)
+    , FilteredEndSequence(0)
+    , bVirtualized(bInVirtualized)
+    , FirstRow(0)
+    , ExpandedRowsStart(0)
+    , ExpandedRowsEnd(0)
+    , OldestGroupSequence(0)
+    , bGroupSortPending(false)
+    , LastGroupSortTime(0.0)
+    , bRowsDirty(bInVirtualized)
+    , WindowStart(0)
+    , WindowSize(1)
+    , CachedNumMessages(0)
+    , bNumMessagesCacheDirty(true)
     , Filter(InFilter)
+    , FilterResults(InMessages->GetMaxMessages())
     , TextLayout(nullptr)
+    , LinkCandidates(LinkDefs::MaxMemoizedMessages)
+    , NumLinesWaitingForPaths(0)
     , UrlPattern(FRegexPattern(FString("\\b(((https?://)?www\\d{0,3}[.]|(https?://))([^\\s()<>]+|\\(([^\\s()<>]+|(\\([^\\s()<>]+\\)))*\\))+(\\(([^\\s()<>]+|(\\([^\\s()<>]+\\)))*\\)|[^\\s`!()\\[\\]{};:'\"., <>?\xAB\xBB\x93\x94\x91\x92]))")))
 #if PLATFORM_MAC || PLATFORM_LINUX
     , FilePathPattern(FRegexPattern(FString("\"((?:/[^/]*)+)/?\"|((?:/[^/ \\n]*)+/?)")))
@@ -1054,6 +1993,9 @@ FOutputLogTextLayoutMarshaller::FOutputLogTextLayoutMarshaller(TArray< TSharedPt
     , FilePathPattern(FRegexPattern(FString("\"((?:[a-zA-Z]:|\\\\\\\\\\w[ \\w\\.]*)(?:[\\\\/]\\w[^\"\\n] * ) + )\"|'((?:[a-zA-Z]:|\\\\\\\\\\w[ \\w\\.]*)(?:[\\\\/]\\w[^'\\n]*)+)'|((?:[a-zA-Z]:|\\\\\\\\\\w[\\w\\.]*)(?:[\\\\/]\\w[^ \\n]*)+)")))
 #endif
 {
+    MessagesEvictedHandle = Messages->OnMessagesEvicted().AddRaw(this, &FOutputLogTextLayoutMarshaller::OnMessagesEvicted);
+    SettingChangedHandle = GetMutableDefault<ULogDisplaySettings>()->OnSettingChanged().AddRaw(this, &FOutputLogTextLayoutMarshaller::OnSettingChanged);
+    CategoryMatcher.Compile(GetDefault<ULogDisplaySettings>()->LogCategories);
 }
 
 #include <iostream>
@@ -1083,6 +2025,48 @@ void FCustomTextLayout::RemoveSingleLineFromLayout()
     }
 }
 
+void FCustomTextLayout::RemoveLinesFromStart(int32 NumLines)
+{
+    NumLines = FMath::Min(NumLines, LineModels.Num());
+    if (NumLines <= 0) {
+        return;
+    }
+    LineModels.RemoveAt(0, NumLines, false);
+    DirtyFlags |= ETextLayoutDirtyState::Layout;
+}
+
+void FCustomTextLayout::RemoveLines(const TArray<int32>& LineIndices)
+{
+    if (LineIndices.Num() == 0) {
+        return;
+    }
+
+    // Compact the remaining lines in a single pass
+    int32 NumKept = LineIndices[0];
+    for (int32 LineIndex = LineIndices[0], NextRemoved = 0; LineIndex < LineModels.Num(); LineIndex++) {
+        if (NextRemoved < LineIndices.Num() && LineIndices[NextRemoved] == LineIndex) {
+            NextRemoved++;
+            continue;
+        }
+        LineModels[NumKept++] = MoveTemp(LineModels[LineIndex]);
+    }
+    LineModels.SetNum(NumKept, false);
+    DirtyFlags |= ETextLayoutDirtyState::Layout;
+}
+
+void FCustomTextLayout::ReplaceRuns(int32 LineIndex, int32 TextOffset, const TArray<TSharedRef<IRun>>& Runs)
+{
+    FLineModel& LineModel = LineModels[LineIndex];
+    while (LineModel.Runs.Num() > 0 && LineModel.Runs.Last().GetTextRange().BeginIndex >= TextOffset) {
+        LineModel.Runs.Pop(false);
+    }
+    for (const TSharedRef<IRun>& Run : Runs) {
+        LineModel.Runs.Add(FRunModel(Run));
+    }
+    LineModel.DirtyFlags |= ELineModelDirtyState::All;
+    DirtyFlags |= ETextLayoutDirtyState::Layout;
+}
+
 void FCustomTextLayout::AddEmptyRun()
 {
     TSharedRef<FString> LineText = MakeShareable(new FString());
@@ -1095,7 +2079,16 @@ void FCustomTextLayout::AddEmptyRun()
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SOutputLog::Construct(const FArguments& InArgs)
 {
-    MessagesTextMarshaller = FOutputLogTextLayoutMarshaller::Create(InArgs._Messages, &Filter);
+    MessageStore = InArgs._MessageStore;
+    const bool bVirtualized = GetDefault<ULogDisplaySettings>()->bVirtualizedView;
+    MessagesTextMarshaller = FOutputLogTextLayoutMarshaller::Create(MessageStore.ToSharedRef(), InArgs._BlueprintLinks, &Filter, bVirtualized);
+
+    // The virtualized text box only holds the rows that fit into it, so it never scrolls by itself
+    TSharedPtr<SScrollBar> TextBoxScrollBar;
+    if (bVirtualized)
+    {
+        TextBoxScrollBar = SNew(SScrollBar).Visibility(EVisibility::Collapsed);
+    }
 
     MessagesTextBox = SNew(SMultiLineEditableTextBox)
         .Style(FEditorStyle::Get(), "Log.TextBox")
@@ -1103,11 +2096,38 @@ void SOutputLog::Construct(const FArguments& InArgs)
         .ForegroundColor(FLinearColor::Gray)
         .Marshaller(MessagesTextMarshaller)
         .IsReadOnly(true)
-        .AlwaysShowScrollbars(true)
+        .AutoWrapText(true)
+        .WrappingPolicy(ETextWrappingPolicy::AllowPerCharacterWrapping)
+        .AlwaysShowScrollbars(!bVirtualized)
+        .VScrollBar(TextBoxScrollBar)
         .OnVScrollBarUserScrolled(this, &SOutputLog::OnUserScrolled)
         .CreateSlateTextLayout(FCreateSlateTextLayout::CreateStatic(&FCustomTextLayout::CreateLayout))
         .ContextMenuExtender(this, &SOutputLog::ExtendTextBoxMenu);
 
+    TSharedRef<SWidget> LogArea = MessagesTextBox.ToSharedRef();
+    VirtualLineHeight = 0.0f;
+    VirtualNumVisibleRows = 0;
+    VirtualScrolledWindowStart = INDEX_NONE;
+    if (bVirtualized)
+    {
+        const FTextBlockStyle& LogTextStyle = FEditorStyle::Get().GetWidgetStyle<FTextBlockStyle>("Log.Normal");
+        VirtualLineHeight = FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->GetMaxCharacterHeight(LogTextStyle.Font);
+
+        LogArea = SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .FillWidth(1)
+            [
+                MessagesTextBox.ToSharedRef()
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SAssignNew(VirtualScrollBar, SScrollBar)
+                .AlwaysShowScrollbar(true)
+                .OnUserScrolled(this, &SOutputLog::OnVirtualScrollBarScrolled)
+            ];
+    }
+
     ChildSlot
 	[
 		SNew(SVerticalBox)
@@ -1172,13 +2192,23 @@ void SOutputLog::Construct(const FArguments& InArgs)
                         .OnTextCommitted(this, &SOutputLog::OnFilterTextCommitted)
 						.DelayChangeNotificationsWhileTyping(true)
 					]
+
+					+SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					.Padding(4, 1, 0, 0)
+					[
+						SNew(STextBlock)
+						.Text(this, &SOutputLog::GetSearchStatusText)
+						.Visibility(this, &SOutputLog::GetSearchStatusVisibility)
+					]
 				]
 
 				// Output log area
 				+SVerticalBox::Slot()
 				.FillHeight(1)
 				[
-					MessagesTextBox.ToSharedRef()
+					LogArea
 				]
 			]
 		]
@@ -1196,8 +2226,6 @@ void SOutputLog::Construct(const FArguments& InArgs)
 		]
 	];
 
-    GLog->AddOutputDevice(this);
-
     bIsUserScrolled = false;
     RequestForceScroll();
 }
@@ -1205,100 +2233,124 @@ END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 SOutputLog::~SOutputLog()
 {
-    if (GLog != NULL)
+}
+
+namespace LogIngestDefs
+{
+    // Tabs are replaced by spaces up to the next tab stop like FString::ConvertTabsToSpaces(4)
+    static const int32 SpacesPerTab = 4;
+
+    /** Returns true for the terminator and the characters FTextRange::CalculateLineRangesFromString splits lines at */
+    FORCEINLINE bool IsLineEnd(TCHAR Char)
     {
-        GLog->RemoveOutputDevice(this);
+        // Almost every character is above \r and below the first line break outside of ASCII
+        return !(Char > TEXT('\r') && Char < 0x85) && (Char == 0 || FChar::IsLinebreak(Char));
     }
 }
 
-bool SOutputLog::CreateLogMessages(const TCHAR* message, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time, TArray< TSharedPtr<FLogMessage> >& OutMessages)
+bool SOutputLog::CreateLogMessages(const TCHAR* message, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time, ELogTimes::Type TimestampMode, FLogMessageStore& OutMessages)
 {
-    if (Verbosity == ELogVerbosity::SetColor)
+    if (Verbosity == ELogVerbosity::SetColor || message == nullptr || *message == 0)
     {
         // Skip Color Events
         return false;
     }
 
+    static const FName CommandStyle(TEXT("Log.Command"));
+    static const FName ErrorStyle(TEXT("Log.Error"));
+    static const FName WarningStyle(TEXT("Log.Warning"));
+    static const FName NormalStyle(TEXT("Log.Normal"));
+
     FName Style;
     if (Category == NAME_Cmd)
     {
-        Style = FName(TEXT("Log.Command"));
+        Style = CommandStyle;
     }
     else if (Verbosity == ELogVerbosity::Error)
     {
-        Style = FName(TEXT("Log.Error"));
+        Style = ErrorStyle;
     }
     else if (Verbosity == ELogVerbosity::Warning)
     {
-        Style = FName(TEXT("Log.Warning"));
+        Style = WarningStyle;
     }
     else
     {
-        Style = FName(TEXT("Log.Normal"));
+        Style = NormalStyle;
     }
 
-    // Determine how to format timestamps
-    static ELogTimes::Type LogTimestampMode = ELogTimes::SinceGStartTime;
-    if (UObjectInitialized() && !GExitPurge)
-    {
-        // Logging can happen very late during shutdown, even after the UObject system has been torn down, hence the init check above
-        LogTimestampMode = GetDefault<UEditorStyleSettings>()->LogTimestampMode;
-    }
-
-    const int32 OldNumMessages = OutMessages.Num();
-
-    // handle multiline strings by breaking them apart by line
-    TArray<FTextRange> LineRanges;
-    FString CurrentLogDump = message;
-    FTextRange::CalculateLineRangesFromString(CurrentLogDump, LineRanges);
-
+    // Only the first line of the message gets the prefix
+    const FString MessagePrefix = FOutputDeviceHelper::FormatLogLine(Verbosity, Category, nullptr, TimestampMode, Time);
     bool bIsFirstLineInMessage = true;
-    for (const FTextRange& LineRange : LineRanges)
+    bool bAddedLines = false;
+
+    // The message is split into lines at the same line breaks as FTextRange::CalculateLineRangesFromString does, empty lines are skipped.
+    // Each line becomes a single message however long it is, the views wrap it to their width.
+    const TCHAR* Char = message;
+    while (*Char)
     {
-        if (!LineRange.IsEmpty())
+        const TCHAR* LineEnd = Char;
+        int32 NumTabs = 0;
+        for (; !LogIngestDefs::IsLineEnd(*LineEnd); LineEnd++)
         {
-            FString Line = CurrentLogDump.Mid(LineRange.BeginIndex, LineRange.Len());
-            Line = Line.ConvertTabsToSpaces(4);
+            NumTabs += *LineEnd == TEXT('\t') ? 1 : 0;
+        }
 
-            // Hard-wrap lines to avoid them being too long
-            static const int32 HardWrapLen = 360;
-            for (int32 CurrentStartIndex = 0; CurrentStartIndex < Line.Len();)
+        if (LineEnd > Char)
+        {
+            // The line is written straight into the store, expanding the tabs on the way
+            const int32 PrefixLen = bIsFirstLineInMessage ? MessagePrefix.Len() : 0;
+            const int32 LineLen = (int32)(LineEnd - Char);
+            TCHAR* const Text = OutMessages.BeginMessage(PrefixLen + LineLen + NumTabs * (LogIngestDefs::SpacesPerTab - 1));
+            FMemory::Memcpy(Text, *MessagePrefix, PrefixLen * sizeof(TCHAR));
+
+            TCHAR* const LineStart = Text + PrefixLen;
+            TCHAR* Out = LineStart;
+            if (NumTabs == 0)
+            {
+                FMemory::Memcpy(Out, Char, LineLen * sizeof(TCHAR));
+                Out += LineLen;
+            }
+            else
             {
-                int32 HardWrapLineLen = 0;
-                if (bIsFirstLineInMessage)
+                for (const TCHAR* In = Char; In < LineEnd; In++)
                 {
-                    FString MessagePrefix = FOutputDeviceHelper::FormatLogLine(Verbosity, Category, nullptr, LogTimestampMode, Time);
-
-                    HardWrapLineLen = FMath::Min(HardWrapLen - MessagePrefix.Len(), Line.Len() - CurrentStartIndex);
-                    FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
-
-                    OutMessages.Add(MakeShareable(new FLogMessage(MakeShareable(new FString(MessagePrefix + HardWrapLine)), Verbosity, Style, Category)));
+                    if (*In == TEXT('\t'))
+                    {
+                        const int32 NumSpaces = LogIngestDefs::SpacesPerTab - ((int32)(Out - LineStart) % LogIngestDefs::SpacesPerTab);
+                        for (int32 Space = 0; Space < NumSpaces; Space++)
+                        {
+                            *Out++ = TEXT(' ');
+                        }
+                    }
+                    else
+                    {
+                        *Out++ = *In;
+                    }
                 }
-                else
-                {
-                    HardWrapLineLen = FMath::Min(HardWrapLen, Line.Len() - CurrentStartIndex);
-                    FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
+            }
 
-                    OutMessages.Add(MakeShareable(new FLogMessage(MakeShareable(new FString(MoveTemp(HardWrapLine))), Verbosity, Style, Category)));
-                }
+            OutMessages.CommitMessage((int32)(Out - Text), PrefixLen, Verbosity, Category, Style, Time);
+            bAddedLines = true;
+            bIsFirstLineInMessage = false;
+        }
 
-                bIsFirstLineInMessage = false;
-                CurrentStartIndex += HardWrapLineLen;
-            }
+        Char = LineEnd;
+        if (*Char)
+        {
+            // A \r\n chain is a single line break
+            Char += (Char[0] == TEXT('\r') && Char[1] == TEXT('\n')) ? 2 : 1;
         }
     }
 
-    return OldNumMessages != OutMessages.Num();
+    return bAddedLines;
 }
 
-void SOutputLog::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category)
+void SOutputLog::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
-    Serialize(V, Verbosity, Category, -1);
-}
+    SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
 
-void SOutputLog::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time)
-{
-    if (MessagesTextMarshaller->AppendMessage(V, Verbosity, Time, Category))
+    if (MessagesTextMarshaller->AppendPendingMessages(GetDefault<ULogDisplaySettings>()->MaxLinesPerFrame))
     {
         // Don't scroll to the bottom automatically when the user is scrolling the view or has scrolled it away from the bottom.
         if (!bIsUserScrolled)
@@ -1306,6 +2358,67 @@ void SOutputLog::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const
             RequestForceScroll();
         }
     }
+
+    MessagesTextMarshaller->UpdateFilePathLinks();
+    MessagesTextMarshaller->UpdatePendingLinks();
+
+    if (VirtualScrollBar.IsValid())
+    {
+        UpdateVirtualView();
+    }
+}
+
+FReply SOutputLog::OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+    if (!VirtualScrollBar.IsValid())
+    {
+        return SCompoundWidget::OnMouseWheel(MyGeometry, MouseEvent);
+    }
+
+    const int32 NumRowsToScroll = -FMath::RoundToInt(MouseEvent.GetWheelDelta() * VirtualViewDefs::RowsPerWheelStep);
+    ScrollVirtualView(MessagesTextMarshaller->GetWindowStart() + NumRowsToScroll);
+    return FReply::Handled();
+}
+
+void SOutputLog::OnVirtualScrollBarScrolled(float ScrollOffset)
+{
+    ScrollVirtualView(FMath::RoundToInt(ScrollOffset * MessagesTextMarshaller->GetNumRows()));
+}
+
+void SOutputLog::ScrollVirtualView(int32 FirstVisibleRow)
+{
+    MessagesTextMarshaller->SetWindow(FirstVisibleRow, VirtualNumVisibleRows);
+    bIsUserScrolled = MessagesTextMarshaller->GetWindowStart() + VirtualNumVisibleRows < MessagesTextMarshaller->GetNumRows();
+    UpdateVirtualView();
+}
+
+void SOutputLog::UpdateVirtualView()
+{
+    const float Padding = FEditorStyle::Get().GetWidgetStyle<FEditableTextBoxStyle>("Log.TextBox").Padding.GetTotalSpaceAlong<Orient_Vertical>();
+    const float TextHeight = MessagesTextBox->GetTickSpaceGeometry().GetLocalSize().Y - Padding - VirtualViewDefs::VerticalSlack;
+    const int32 NumVisibleRows = FMath::Max(1, FMath::FloorToInt(TextHeight / FMath::Max(VirtualLineHeight, 1.0f)));
+    if (NumVisibleRows != VirtualNumVisibleRows)
+    {
+        VirtualNumVisibleRows = NumVisibleRows;
+        const int32 FirstVisibleRow = bIsUserScrolled ? MessagesTextMarshaller->GetWindowStart() : MessagesTextMarshaller->GetNumRows() - NumVisibleRows;
+        MessagesTextMarshaller->SetWindow(FirstVisibleRow, NumVisibleRows);
+    }
+
+    const int32 NumRows = FMath::Max(MessagesTextMarshaller->GetNumRows(), 1);
+    VirtualScrollBar->SetState((float)MessagesTextMarshaller->GetWindowStart() / NumRows, FMath::Min(1.0f, (float)VirtualNumVisibleRows / NumRows));
+
+    // Long rows wrap, so the rows of the window can take more lines than fit into the text box.
+    // While following the log the text box shows the end of the window, otherwise it shows the first row of the window.
+    if (!bIsUserScrolled)
+    {
+        MessagesTextBox->ScrollTo(MessagesTextMarshaller->GetLayoutEnd());
+        VirtualScrolledWindowStart = INDEX_NONE;
+    }
+    else if (VirtualScrolledWindowStart != MessagesTextMarshaller->GetWindowStart())
+    {
+        MessagesTextBox->ScrollTo(FTextLocation(0));
+        VirtualScrolledWindowStart = MessagesTextMarshaller->GetWindowStart();
+    }
 }
 
 void SOutputLog::ExtendTextBoxMenu(FMenuBuilder& Builder)
@@ -1350,6 +2463,13 @@ void SOutputLog::OnConsoleCommandExecuted()
 
 void SOutputLog::RequestForceScroll()
 {
+    if (MessagesTextMarshaller->IsVirtualized())
+    {
+        MessagesTextMarshaller->SetWindow(MessagesTextMarshaller->GetNumFilteredMessages() - VirtualNumVisibleRows, VirtualNumVisibleRows);
+        bIsUserScrolled = false;
+        return;
+    }
+
     if (MessagesTextMarshaller->GetNumFilteredMessages() > 0)
     {
         MessagesTextBox->ScrollTo(FTextLocation(MessagesTextMarshaller->GetNumFilteredMessages() - 1));
@@ -1368,10 +2488,35 @@ void SOutputLog::Refresh()
     RequestForceScroll();
 }
 
+FText SOutputLog::GetSearchStatusText() const
+{
+    return FText::Format(LOCTEXT("SearchingLog", "Searching... {0} matches so far"), FText::AsNumber(MessagesTextMarshaller->GetNumSearchMatches()));
+}
+
+EVisibility SOutputLog::GetSearchStatusVisibility() const
+{
+    return MessagesTextMarshaller->IsSearching() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
 void SOutputLog::OnFilterTextChanged(const FText& InFilterText)
 {
+    // Typing usually extends or shortens the search text, then only a part of the cached filter results has to be checked again
+    switch (Filter.CompareFilterText(InFilterText))
+    {
+    case FLogFilter::EFilterTextChange::Unchanged:
+        return;
+    case FLogFilter::EFilterTextChange::Narrower:
+        MessagesTextMarshaller->MarkMessagesFilterAsNarrowed();
+        break;
+    case FLogFilter::EFilterTextChange::Wider:
+        MessagesTextMarshaller->MarkMessagesFilterAsWidened();
+        break;
+    default:
+        MessagesTextMarshaller->MarkMessagesFilterAsDirty();
+        break;
+    }
+
     // Flag the messages count as dirty
-    MessagesTextMarshaller->MarkMessagesFilterAsDirty();
     MessagesTextMarshaller->MarkMessagesCacheAsDirty();
 
     // Set filter phrases
@@ -1418,6 +2563,39 @@ TSharedRef<SWidget> SOutputLog::MakeAddFilterMenu()
             EUserInterfaceActionType::ToggleButton
         );
 
+        MenuBuilder.AddMenuEntry(
+            LOCTEXT("GroupDuplicates", "Group Duplicates"),
+            LOCTEXT("GroupDuplicates_Tooltip", "Shows every distinct message only once, with the number of times it has been logged. The line moves to the end whenever the message is logged again."),
+            FSlateIcon(),
+            FUIAction(FExecuteAction::CreateSP(this, &SOutputLog::MenuGroupDuplicates_Execute),
+                FCanExecuteAction::CreateSP(this, &SOutputLog::Menu_CanExecute),
+                FIsActionChecked::CreateSP(this, &SOutputLog::MenuGroupDuplicates_IsChecked)),
+            NAME_None,
+            EUserInterfaceActionType::ToggleButton
+        );
+
+        MenuBuilder.AddMenuEntry(
+            LOCTEXT("GroupByTemplate", "Group By Message Shape"),
+            LOCTEXT("GroupByTemplate_Tooltip", "Messages that only differ in numbers, GUIDs, addresses or quoted names are grouped as duplicates"),
+            FSlateIcon(),
+            FUIAction(FExecuteAction::CreateSP(this, &SOutputLog::MenuGroupByTemplate_Execute),
+                FCanExecuteAction::CreateSP(this, &SOutputLog::MenuGroupOptions_CanExecute),
+                FIsActionChecked::CreateSP(this, &SOutputLog::MenuGroupByTemplate_IsChecked)),
+            NAME_None,
+            EUserInterfaceActionType::ToggleButton
+        );
+
+        MenuBuilder.AddMenuEntry(
+            LOCTEXT("SortGroupsByCount", "Sort Groups By Count"),
+            LOCTEXT("SortGroupsByCount_Tooltip", "Lists the most frequent messages first. Clicking the counter of a message lists all of its occurrences below it."),
+            FSlateIcon(),
+            FUIAction(FExecuteAction::CreateSP(this, &SOutputLog::MenuSortGroupsByCount_Execute),
+                FCanExecuteAction::CreateSP(this, &SOutputLog::MenuGroupOptions_CanExecute),
+                FIsActionChecked::CreateSP(this, &SOutputLog::MenuSortGroupsByCount_IsChecked)),
+            NAME_None,
+            EUserInterfaceActionType::ToggleButton
+        );
+
         MenuBuilder.AddMenuEntry(
             LOCTEXT("AntiSpamMessages", "Anti Spam Mode"),
             LOCTEXT("AntiSpamMessages_Tooltip", "Filters out common and uninteresting log messages"),
@@ -1515,6 +2693,26 @@ bool SOutputLog::MenuCollapsed_IsChecked() const
     return Filter.bCollapsedMode;
 }
 
+bool SOutputLog::MenuGroupDuplicates_IsChecked() const
+{
+    return Filter.bGroupDuplicates;
+}
+
+bool SOutputLog::MenuGroupByTemplate_IsChecked() const
+{
+    return Filter.bGroupByTemplate;
+}
+
+bool SOutputLog::MenuSortGroupsByCount_IsChecked() const
+{
+    return Filter.bSortGroupsByCount;
+}
+
+bool SOutputLog::MenuGroupOptions_CanExecute() const
+{
+    return Filter.bGroupDuplicates;
+}
+
 bool SOutputLog::MenuAntiSpam_IsChecked() const
 {
     return Filter.bAntiSpamMode;
@@ -1550,7 +2748,37 @@ void SOutputLog::MenuCollapsed_Execute()
     Filter.bCollapsedMode = !Filter.bCollapsedMode;
 
     // Flag the messages count as dirty
-    MessagesTextMarshaller->MarkMessagesFilterAsDirty();
+    MessagesTextMarshaller->MarkMessagesGroupingAsDirty();
+    MessagesTextMarshaller->MarkMessagesCacheAsDirty();
+    Refresh();
+}
+
+void SOutputLog::MenuGroupDuplicates_Execute()
+{
+    Filter.bGroupDuplicates = !Filter.bGroupDuplicates;
+
+    // Flag the messages count as dirty
+    MessagesTextMarshaller->MarkMessagesGroupingAsDirty();
+    MessagesTextMarshaller->MarkMessagesCacheAsDirty();
+    Refresh();
+}
+
+void SOutputLog::MenuGroupByTemplate_Execute()
+{
+    Filter.bGroupByTemplate = !Filter.bGroupByTemplate;
+
+    // Flag the messages count as dirty
+    MessagesTextMarshaller->MarkMessagesGroupingAsDirty();
+    MessagesTextMarshaller->MarkMessagesCacheAsDirty();
+    Refresh();
+}
+
+void SOutputLog::MenuSortGroupsByCount_Execute()
+{
+    Filter.bSortGroupsByCount = !Filter.bSortGroupsByCount;
+
+    // Flag the messages count as dirty
+    MessagesTextMarshaller->MarkMessagesGroupingAsDirty();
     MessagesTextMarshaller->MarkMessagesCacheAsDirty();
     Refresh();
 }
@@ -1595,49 +2823,33 @@ void SOutputLog::MenuErrors_Execute()
     Refresh();
 }
 
-bool FLogFilter::IsMessageAllowed(const TSharedPtr<FLogMessage>& Message)
-{
-    if (Message->filter != UNKNOWN) {
-        return Message->filter == VISIBLE;
-    }
-    bool visible = checkMessage(Message);
-    Message->filter = visible ? VISIBLE : HIDDEN;
-    return visible;
-}
-
-bool FLogFilter::checkMessage(const TSharedPtr<FLogMessage>& Message)
+bool FLogFilter::IsMessageAllowed(const FLogMessage& Message) const
 {
     // Filter Verbosity
     {
-        if (Message->Verbosity == ELogVerbosity::Error && !bShowErrors)
+        if (Message.Verbosity == ELogVerbosity::Error && !bShowErrors)
         {
-            Message->filter = HIDDEN;
             return false;
         }
 
-        if (Message->Verbosity == ELogVerbosity::Warning && !bShowWarnings)
+        if (Message.Verbosity == ELogVerbosity::Warning && !bShowWarnings)
         {
-            Message->filter = HIDDEN;
             return false;
         }
 
-        if (Message->Verbosity != ELogVerbosity::Error && Message->Verbosity != ELogVerbosity::Warning && !bShowLogs)
+        if (Message.Verbosity != ELogVerbosity::Error && Message.Verbosity != ELogVerbosity::Warning && !bShowLogs)
         {
-            Message->filter = HIDDEN;
             return false;
         }
 
-        if (!bShowCommands && Message->Category == NAME_Cmd) {
-            Message->filter = HIDDEN;
+        if (!bShowCommands && Message.Category == NAME_Cmd) {
             return false;
         }
     }
 
     // AntiSpam filter
-    if (bAntiSpamMode && Message->Verbosity != ELogVerbosity::Warning && Message->Verbosity != ELogVerbosity::Error) {
-        smatch matcher;
-        bool found = regex_search(Message->CString, matcher, antiSpamRegex);
-        if (found) {
+    if (bAntiSpamMode && Message.Verbosity != ELogVerbosity::Warning && Message.Verbosity != ELogVerbosity::Error) {
+        if (antiSpamMatcher->IsMatch(Message.Text, Message.Len)) {
             return false;
         }
     }
@@ -1647,12 +2859,17 @@ bool FLogFilter::checkMessage(const TSharedPtr<FLogMessage>& Message)
         if (TextFilterExpressionEvaluator.GetFilterText().IsEmpty()) {
             return true;
         }
-        smatch matcher;
-        if (!regex_search(Message->CString, matcher, bIsRegexValid ? searchRegex : lastValidRegex)) {
+        if (lastValidRegex.IsValid() && !lastValidRegex->IsMatch(Message.Text, Message.Len)) {
             return false;
         }
     }
-    else if (!TextFilterExpressionEvaluator.TestTextFilter(FLogFilter_TextFilterExpressionContext(*Message)))
+    else if (bIsLiteralTextFilter) {
+        // A single search term is searched for directly, without evaluating an expression
+        if (!FLogLiteralSearch::Contains(Message.Text, Message.Len, *literalFilterText, literalFilterText.Len())) {
+            return false;
+        }
+    }
+    else if (!TextFilterExpressionEvaluator.TestTextFilter(FLogFilter_TextFilterExpressionContext(Message)))
     {
         return false;
     }
@@ -1660,9 +2877,66 @@ bool FLogFilter::checkMessage(const TSharedPtr<FLogMessage>& Message)
     return true;
 }
 
+FLogFilter::EFilterTextChange FLogFilter::CompareFilterText(const FText& InFilterText) const
+{
+    const FString OldText = TextFilterExpressionEvaluator.GetFilterText().ToString();
+    const FString NewText = InFilterText.ToString();
+    if (NewText.Equals(OldText, ESearchCase::CaseSensitive))
+    {
+        return EFilterTextChange::Unchanged;
+    }
+
+    // Both search modes ignore the case. A line containing the longer text also contains the shorter one, the empty text passes every line.
+    if (IsLiteralSearch(OldText) && IsLiteralSearch(NewText))
+    {
+        if (NewText.Contains(OldText, ESearchCase::IgnoreCase))
+        {
+            return EFilterTextChange::Narrower;
+        }
+        if (OldText.Contains(NewText, ESearchCase::IgnoreCase))
+        {
+            return EFilterTextChange::Wider;
+        }
+    }
+    return EFilterTextChange::Unrelated;
+}
+
+bool FLogFilter::IsLiteralSearch(const FString& SearchText) const
+{
+    if (bUseRegex)
+    {
+        for (TCHAR Char : SearchText)
+        {
+            if (FCString::Strchr(TEXT("\\^$.|?*+()[]{}"), Char))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    return IsSingleTextFilterTerm(SearchText);
+}
+
+bool FLogFilter::IsSingleTextFilterTerm(const FString& SearchText)
+{
+    // The basic string evaluator splits the text at whitespace and knows operators
+    if (SearchText.Equals(TEXT("AND"), ESearchCase::IgnoreCase) || SearchText.Equals(TEXT("OR"), ESearchCase::IgnoreCase) || SearchText.Equals(TEXT("NOT"), ESearchCase::IgnoreCase))
+    {
+        return false;
+    }
+    for (TCHAR Char : SearchText)
+    {
+        if (FChar::IsWhitespace(Char) || FCString::Strchr(TEXT("\"'!-+|&()=<>:"), Char))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 FText FLogFilter::getInValidRegexText()
 {
-    return LOCTEXT("InvalidRegex", "Invalid regex");
+    return FText::Format(LOCTEXT("InvalidRegex", "Invalid regex: {0}"), FText::FromString(regexError));
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -5,41 +5,22 @@
 #include "Framework/Text/BaseTextLayoutMarshaller.h"
 #include "Misc/TextFilterExpressionEvaluator.h"
 #include "Internationalization/Regex.h"
-#include <map>
-#include <regex>
 #include "Framework/Text/SlateTextLayout.h"
 #include "LogDisplaySettings.h"
+#include "LogMessageStore.h"
+#include "LogFilterResultCache.h"
+#include "BlueprintLinkIndex.h"
+#include "LogCategoryMatcher.h"
+#include "LogRegex.h"
+#include "LogAntiSpamMatcher.h"
+#include "LogMessageGroups.h"
+#include "LogPathExistenceCache.h"
+#include "Containers/LruCache.h"
 
 class FOutputLogTextLayoutMarshaller;
+class FLogFilterSearch;
 class SSearchBox;
 
-enum FilterStatus {
-    UNKNOWN, VISIBLE, HIDDEN
-};
-
-/**
-* A single log message for the output log, holding a single message
-*/
-struct FLogMessage
-{
-	TSharedRef<FString> Message;
-	ELogVerbosity::Type Verbosity;
-	FName Style;
-    FName Category;
-    int32 Count = 1;
-    std::string CString;
-    FilterStatus filter = UNKNOWN;
-
-	FLogMessage(const TSharedRef<FString>& NewMessage, ELogVerbosity::Type NewVerbosity, FName NewStyle, FName Category)
-		: Message(NewMessage)
-		, Verbosity(NewVerbosity)
-		, Style(NewStyle)
-        , Category(Category)
-        , CString(TCHAR_TO_UTF8(**NewMessage))
-	{
-	}
-};
-
 /**
  * Console input box with command-completion support
  */
@@ -158,6 +139,15 @@ struct FLogFilter
     /** true to collapse repeated messages. */
     bool bCollapsedMode = true;
 
+    /** true to show every distinct message only once, no matter where it is repeated. Overrides the collapsed mode. */
+    bool bGroupDuplicates = false;
+
+    /** true to group messages by their template, so messages that only differ in numbers, ids or quoted names are duplicates */
+    bool bGroupByTemplate = true;
+
+    /** true to sort the groups by their number of messages instead of by their newest message */
+    bool bSortGroupsByCount = false;
+
     /** true to filter common messages. */
     bool bAntiSpamMode = true;
 
@@ -170,29 +160,51 @@ struct FLogFilter
 		bShowErrors = bShowLogs = bShowWarnings = true;
 
         const auto Settings = GetDefault<ULogDisplaySettings>();
-        antiSpamRegex = std::regex(TCHAR_TO_ANSI(*Settings->AntiSpamRegex), std::regex_constants::nosubs | std::regex_constants::optimize);
+        antiSpamMatcher = MakeShareable(new FLogAntiSpamMatcher(Settings->AntiSpamRegex));
 	}
 
 	/** Returns true if any messages should be filtered out */
-	bool IsFilterSet() { return bUseRegex || bCollapsedMode || bAntiSpamMode || !bShowCommands || !bShowErrors || !bShowLogs || !bShowWarnings || TextFilterExpressionEvaluator.GetFilterType() != ETextFilterExpressionType::Empty || !TextFilterExpressionEvaluator.GetFilterText().IsEmpty(); }
+	bool IsFilterSet() { return bUseRegex || bCollapsedMode || bGroupDuplicates || bAntiSpamMode || !bShowCommands || !bShowErrors || !bShowLogs || !bShowWarnings || TextFilterExpressionEvaluator.GetFilterType() != ETextFilterExpressionType::Empty || !TextFilterExpressionEvaluator.GetFilterText().IsEmpty(); }
 
 	/** Checks the given message against set filters */
-	bool IsMessageAllowed(const TSharedPtr<FLogMessage>& Message);
+	bool IsMessageAllowed(const FLogMessage& Message) const;
+
+	/** How the set of messages passing the filter changes if the filter text is replaced */
+	enum class EFilterTextChange : uint8
+	{
+		/** The same messages pass */
+		Unchanged,
+
+		/** Only messages that passed before can pass */
+		Narrower,
+
+		/** All messages that passed before still pass */
+		Wider,
+
+		/** Every message has to be checked again */
+		Unrelated,
+	};
+
+	/** Compares the current filter text with the given one, to be called before it is set */
+	EFilterTextChange CompareFilterText(const FText& InFilterText) const;
 
 	/** Set the Text to be used as the Filter's restrictions */
 	void SetFilterText(const FText& InFilterText) {
         TextFilterExpressionEvaluator.SetFilterText(InFilterText);
 
+        // Stored independent of the search mode, because the mode can be switched without setting the text again
+        bIsLiteralTextFilter = IsSingleTextFilterTerm(InFilterText.ToString());
+        literalFilterText = bIsLiteralTextFilter ? InFilterText.ToString().ToUpper() : FString();
+
         if (bUseRegex) {
-            FString regexFilter = InFilterText.ToString();
-            try {
-                searchRegex = std::regex(TCHAR_TO_ANSI(*regexFilter), std::regex_constants::nosubs |
-                    std::regex_constants::icase | std::regex_constants::optimize);
-                bIsRegexValid = true;
-                lastValidRegex = searchRegex;
+            // Keep filtering with the last valid regex while the user is still typing
+            TSharedPtr<const FLogRegex> regex = MakeShareable(new FLogRegex(InFilterText.ToString(), ELogRegexFlags::IgnoreCase));
+            bIsRegexValid = regex->IsValid();
+            if (bIsRegexValid) {
+                lastValidRegex = regex;
             }
-            catch (std::regex_error&) {
-                bIsRegexValid = false;
+            else {
+                regexError = regex->GetError();
             }
         }
     }
@@ -211,11 +223,21 @@ private:
 	/** Expression evaluator that can be used to perform complex text filter queries */
 	FTextFilterExpressionEvaluator TextFilterExpressionEvaluator;
 
-    std::regex searchRegex;
-    std::regex lastValidRegex;
-    std::regex antiSpamRegex;
+    /** Compiled regexes are immutable, so copies of the filter can share them */
+    TSharedPtr<const FLogRegex> lastValidRegex;
+    TSharedPtr<const FLogAntiSpamMatcher> antiSpamMatcher;
+    FString regexError;
     FText getInValidRegexText();
-    bool checkMessage(const TSharedPtr<FLogMessage>& Message);
+
+    /** Upper case filter text if it is a single search term in the text search mode */
+    bool bIsLiteralTextFilter = true;
+    FString literalFilterText;
+
+    /** Returns true if the search text matches itself literally in the current search mode, as opposed to an expression */
+    bool IsLiteralSearch(const FString& SearchText) const;
+
+    /** Returns true if the text search mode treats the search text as a single term without any operators */
+    static bool IsSingleTextFilterTerm(const FString& SearchText);
 };
 
 class FCustomTextLayout : public FSlateTextLayout
@@ -225,6 +247,15 @@ public:
 
     void RemoveSingleLineFromLayout();
 
+    /** Removes the given number of lines from the start of the layout in one go */
+    void RemoveLinesFromStart(int32 NumLines);
+
+    /** Removes the lines with the given indices in one go, the indices have to be sorted */
+    void RemoveLines(const TArray<int32>& LineIndices);
+
+    /** Replaces the runs of the line that start at or after the offset with the given runs, e.g. a plain text run with the runs of the links found in it */
+    void ReplaceRuns(int32 LineIndex, int32 TextOffset, const TArray<TSharedRef<IRun>>& Runs);
+
     void AddEmptyRun();
 
 protected:
@@ -236,17 +267,21 @@ protected:
  * as well as a combo box for entering in new commands
  */
 class SOutputLog 
-	: public SCompoundWidget, public FOutputDevice
+	: public SCompoundWidget
 {
 
 public:
 
 	SLATE_BEGIN_ARGS( SOutputLog )
-		: _Messages()
+		: _MessageStore()
+		, _BlueprintLinks()
 		{}
 		
-		/** All messages captured before this log window has been created */
-		SLATE_ARGUMENT( TArray< TSharedPtr<FLogMessage> >, Messages )
+		/** The log history shared by all log windows */
+		SLATE_ARGUMENT( TSharedPtr<FLogMessageStore>, MessageStore )
+
+		/** Index of the loaded blueprints used to create blueprint hyperlinks, shared by all log windows */
+		SLATE_ARGUMENT( TSharedPtr<FBlueprintLinkIndex>, BlueprintLinks )
 
 	SLATE_END_ARGS()
 
@@ -261,22 +296,23 @@ public:
 	void Construct( const FArguments& InArgs );
 
 	/**
-	 * Creates FLogMessage objects from FOutputDevice log callback
+	 * Adds the lines of an FOutputDevice log callback to the message store
 	 *
 	 * @param	V Message text
 	 * @param Verbosity Message verbosity
 	 * @param Category Message category
-	 * @param OutMessages Array to receive created FLogMessage messages
-	 * @param Filters [Optional] Filters to apply to Messages
+	 * @param Time Seconds since the engine has been started when the message was logged
+	 * @param TimestampMode How the time is formatted in the prefix of the first line
+	 * @param OutMessages Store to receive the created messages, the listeners are not notified
 	 *
 	 * @return true if any messages have been created, false otherwise
 	 */
-	static bool CreateLogMessages(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time, TArray< TSharedPtr<FLogMessage> >& OutMessages);
+	static bool CreateLogMessages(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time, ELogTimes::Type TimestampMode, FLogMessageStore& OutMessages);
 
 protected:
 
-    virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category) override;
-	virtual void Serialize( const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category, const double Time ) override;
+	/** Appends the messages that arrived since the last frame to the log in one batch */
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 
 	/**
 	 * Extends the context menu used by the text box
@@ -304,6 +340,21 @@ protected:
 	/** Request we immediately force scroll to the bottom of the log */
 	void RequestForceScroll();
 
+	/** Scrolls the virtualized view with the mouse wheel */
+	virtual FReply OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+
+	/** Called when the user drags the scroll bar of the virtualized view */
+	void OnVirtualScrollBarScrolled(float ScrollOffset);
+
+	/** Shows the rows of the virtualized view starting at the given row */
+	void ScrollVirtualView(int32 FirstVisibleRow);
+
+	/** Fits the number of rows of the virtualized view to the height of the text box and updates the scroll bar */
+	void UpdateVirtualView();
+
+	/** The log history shared by all log windows */
+	TSharedPtr< FLogMessageStore > MessageStore;
+
 	/** Converts the array of messages into something the text box understands */
 	TSharedPtr< FOutputLogTextLayoutMarshaller > MessagesTextMarshaller;
 
@@ -316,10 +367,26 @@ protected:
 	/** True if the user has scrolled the window upwards */
 	bool bIsUserScrolled;
 
+	/** Scroll bar over all rows of the virtualized view, null if the view is not virtualized */
+	TSharedPtr< SScrollBar > VirtualScrollBar;
+
+	/** Height of a single line in the virtualized view */
+	float VirtualLineHeight;
+
+	/** Number of rows that fit into the virtualized view */
+	int32 VirtualNumVisibleRows;
+
+	/** Start of the window the text box has been scrolled to the top for, INDEX_NONE while following the log */
+	int32 VirtualScrolledWindowStart;
+
 private:
     /** Called by Slate when the filter box changes text. */
 	void OnFilterTextChanged(const FText& InFilterText);
 
+    /** Progress of the background search shown next to the filter box */
+    FText GetSearchStatusText() const;
+    EVisibility GetSearchStatusVisibility() const;
+
     /** Called by Slate when the filter text box is confirmed. */
     void OnFilterTextCommitted(const FText& InFilterText, ETextCommit::Type InCommitType);
 
@@ -362,6 +429,27 @@ private:
     /** Returns the state of "Collapsed". */
     bool MenuCollapsed_IsChecked() const;
 
+    /** Toggles "Group Duplicates" true/false. */
+    void MenuGroupDuplicates_Execute();
+
+    /** Returns the state of "Group Duplicates". */
+    bool MenuGroupDuplicates_IsChecked() const;
+
+    /** Toggles "Group By Message Shape" true/false. */
+    void MenuGroupByTemplate_Execute();
+
+    /** Returns the state of "Group By Message Shape". */
+    bool MenuGroupByTemplate_IsChecked() const;
+
+    /** Toggles "Sort Groups By Count" true/false. */
+    void MenuSortGroupsByCount_Execute();
+
+    /** Returns the state of "Sort Groups By Count". */
+    bool MenuSortGroupsByCount_IsChecked() const;
+
+    /** The grouping options only matter while duplicates are grouped */
+    bool MenuGroupOptions_CanExecute() const;
+
     /** Toggles "AntiSpam" true/false. */
     void MenuAntiSpam_Execute();
 
@@ -387,7 +475,7 @@ class FOutputLogTextLayoutMarshaller : public FBaseTextLayoutMarshaller
 {
 public:
 
-	static TSharedRef< FOutputLogTextLayoutMarshaller > Create(TArray< TSharedPtr<FLogMessage> > InMessages, FLogFilter* InFilter);
+	static TSharedRef< FOutputLogTextLayoutMarshaller > Create(const TSharedRef<FLogMessageStore>& InMessages, const TSharedPtr<FBlueprintLinkIndex>& InBlueprintLinks, FLogFilter* InFilter, bool bInVirtualized);
 
 	virtual ~FOutputLogTextLayoutMarshaller();
 	
@@ -395,7 +483,12 @@ public:
 	virtual void SetText(const FString& SourceString, FTextLayout& TargetTextLayout) override;
 	virtual void GetText(FString& TargetString, const FTextLayout& SourceTextLayout) override;
 
-	bool AppendMessage(const TCHAR* InText, const ELogVerbosity::Type InVerbosity, const double Time, const FName& InCategory);
+	/**
+	 * Adds the messages the view has not seen yet to the text layout, returns true if the store had any new messages
+	 *
+	 * @param MaxNumLines Maximum number of lines to add, the remaining messages are added by the next call
+	 */
+	bool AppendPendingMessages(int32 MaxNumLines);
 	void ClearMessages();
 
 	void CountMessages();
@@ -407,28 +500,234 @@ public:
 
     void MarkMessagesFilterAsDirty();
 
+    /** Only the messages that passed the old filter have to be checked against the new one */
+    void MarkMessagesFilterAsNarrowed();
+
+    /** Only the messages that did not pass the old filter have to be checked against the new one */
+    void MarkMessagesFilterAsWidened();
+
+    /** Only the way the messages are collapsed or grouped has changed, the filter results stay valid and only the rows and groups are rebuilt */
+    void MarkMessagesGroupingAsDirty();
+
+    /** Returns true while the messages are checked against a changed filter in the background */
+    bool IsSearching() const;
+
+    /** Number of messages the running search has found so far */
+    int32 GetNumSearchMatches() const;
+
+    /**
+     * In virtualized mode every line passing the filter is a row, but only the rows inside the window are added to the text layout.
+     * The view maps its scroll position onto the row index, so the layout never holds more lines than fit into the view.
+     */
+    bool IsVirtualized() const { return bVirtualized; }
+
+    /** Virtualized mode: number of rows passing the filter */
+    int32 GetNumRows() const { return Rows.Num() - FirstRow; }
+
+    /** Virtualized mode: index of the first row in the text layout */
+    int32 GetWindowStart() const { return WindowStart - FirstRow; }
+
+    /** Virtualized mode: shows the given number of rows starting at the given row, the start is clamped so the window stays filled */
+    void SetWindow(int32 InWindowStart, int32 InWindowSize);
+
+    /** Returns the location of the end of the last line in the text layout */
+    FTextLocation GetLayoutEnd() const;
+
+    /** Grouped mode sorted by count: lists the messages of the group below its row, or hides them if they are listed already */
+    void ToggleGroupExpansion(uint64 GroupKey);
+
+    /** Queues the lines waiting for file paths whose background checks have found them for UpdatePendingLinks */
+    void UpdateFilePathLinks();
+
+    /** Adds the links to the lines created without them or waiting for file paths, newest lines first and for a limited time per call */
+    void UpdatePendingLinks();
+
 protected:
 
-	FOutputLogTextLayoutMarshaller(TArray< TSharedPtr<FLogMessage> > InMessages, FLogFilter* InFilter);
+	FOutputLogTextLayoutMarshaller(const TSharedRef<FLogMessageStore>& InMessages, const TSharedPtr<FBlueprintLinkIndex>& InBlueprintLinks, FLogFilter* InFilter, bool bInVirtualized);
+
+	/** Appends the messages that have not been added to the text layout yet with a single AddLines call */
+	void AppendMessagesToTextLayout(int32 MaxNumLines);
 
-	void AppendMessageToTextLayout(const TSharedPtr<FLogMessage>& InMessage);
-	void AppendMessagesToTextLayout(const TArray<TSharedPtr<FLogMessage>>& InMessages);
+	/** Virtualized mode: adds the rows of the messages the view has not seen yet, returns true if any row has been added or changed */
+	bool AppendMessagesToRows(int32 MaxNumLines);
 
-    void CreateBlueprintHyperlinks(const TArray<UBlueprint*>& blueprints, TSet<FTextRange>& foundLinkRanges,
-        TSharedRef<FString> LineText, FHyperlinkStyle LinkStyle, std::map<int32, TSharedRef<FSlateHyperlinkRun>> &hyperlinkRuns) const;
+	/** Virtualized mode: filters all messages of the view again */
+	void RebuildRows();
 
-    void CreateFilepathHyperlinks(TSharedRef<FString> LineText, TSet<FTextRange> &foundLinkRanges, FHyperlinkStyle linkStyle,
-        std::map<int32, TSharedRef<FSlateHyperlinkRun>> &hyperlinkRuns) const;
+	/**
+	 * Grouped mode: adds the messages the view has not seen yet to their groups. The rows of all groups that changed are removed
+	 * and added again at the end, so the rows stay ordered by the newest message of their group.
+	 *
+	 * When sorted by count, all rows are sorted again instead, at most once per GroupViewDefs::SortInterval, and no rows are reported as removed.
+	 *
+	 * @param OutRemovedRows Receives the sorted indices into Rows of the removed rows, before they have been removed
+	 * @return Number of rows added at the end, or when sorted by count 1 if the rows have been sorted again and 0 otherwise
+	 */
+	int32 AppendMessagesToGroups(int32 MaxNumLines, TArray<int32>& OutRemovedRows);
 
-    void CreateUrlHyperlinks(TSharedRef<FString> LineText, TSet<FTextRange> &foundLinkRanges, FHyperlinkStyle linkStyle,
-        std::map<int32, TSharedRef<FSlateHyperlinkRun>> &hyperlinkRuns) const;
+	/** Grouped mode sorted by count: builds the rows from the groups, the messages of the expanded group follow its row */
+	void SortRowsByCount();
 
-    FTextBlockStyle GetStyle(const TSharedPtr<FLogMessage>& Message, const ULogDisplaySettings* StyleSettings) const;
+	/** Grouped mode sorted by count: returns true if groups have changed since the rows were sorted and the sort interval has passed */
+	bool IsGroupSortDue() const;
 
-	/** All log messages to show in the text box */
-	TArray< TSharedPtr<FLogMessage> > Messages;
+	/** Grouped mode sorted by count: removes the groups whose newest message is evicted, returns true if any row has to be removed */
+	bool RemoveEvictedGroups(uint64 EvictedEndSequence);
 
-	/** Holds cached numbers of messages to avoid unnecessary re-filtering */
+	/** Grouped mode: returns the key of the group the message belongs to */
+	uint64 GetGroupKey(const FLogMessage& Message) const
+	{
+		return FLogMessageGroups::GetKey(Message, Filter->bGroupByTemplate);
+	}
+
+	/** Virtualized mode: adds the lines of the rows inside the window to the text layout */
+	void AddWindowLines();
+
+	/** Creates one layout line for each of the rows in [StartRow, EndRow) */
+	void CreateRowLines(int32 StartRow, int32 EndRow, TArray<FTextLayout::FNewLineData>& OutLines) const;
+
+	/** Creates up to the given number of lines to update the last line of the layout if its message has been repeated since it was added, returns the number of lines created */
+	int32 CreateRepeatedLastMessageLines(int32 MaxNumLines, TArray<FTextLayout::FNewLineData>& OutLines);
+
+	/**
+	 * Creates the layout lines for a single message, one line per repetition unless in collapsed mode.
+	 * Without virtualization the lines are created without links, they are added later by UpdatePendingLinks.
+	 *
+	 * @param bGroupMessage true if the message is listed below the row of its expanded group
+	 */
+	void CreateMessageLines(uint64 Sequence, int32 NumRepetitions, TArray<FTextLayout::FNewLineData>& OutLines, bool bGroupMessage = false) const;
+
+	/** Checks the message with the given sequence number against the filter of this view, using the cached result if possible */
+	bool IsMessageAllowed(uint64 Sequence) const;
+
+	/** Returns the number of layout lines the message with the given sequence number occupies in this view */
+	int32 GetNumMessageLines(uint64 Sequence) const;
+
+	/** Returns the sequence number of the first message shown in this view */
+	uint64 GetViewStartSequence() const;
+
+	/**
+	 * Collects the results of the running search and checks the messages after FilteredEndSequence against the filter.
+	 * A few messages are checked right away, many messages (e.g. the whole history after the filter has changed) are checked by a background search.
+	 */
+	void FilterPendingMessages();
+
+	/** Removes the lines of messages that are about to be evicted from the store */
+	void OnMessagesEvicted(int32 NumEvicted);
+
+    /** Matches of the link patterns in the text of a message, relative to the start of the message */
+    struct FLinkCandidates
+    {
+        TArray<FTextRange> UrlRanges;
+
+        /** Matched file paths without quotes, whether they exist is checked when the links are created */
+        TArray<FTextRange> PathRanges;
+        TArray<FString> Paths;
+    };
+
+    /** Returns the link candidates of the message, the patterns only run the first time a line of the message is created */
+    const FLinkCandidates& FindLinkCandidates(uint64 Sequence, const FLogMessage& Message) const;
+
+    /** Links of a single line sorted by their start, lines rarely have more than a few so they stay on the stack */
+    typedef TArray<TSharedRef<FSlateHyperlinkRun>, TInlineAllocator<8>> FLineLinks;
+
+    void CreateBlueprintHyperlinks(const TSharedRef<FString>& LineText, int32 TextOffset, const FHyperlinkStyle& LinkStyle, FLineLinks& links) const;
+
+    void CreateFilepathHyperlinks(uint64 Sequence, const TSharedRef<FString>& LineText, int32 TextOffset, const FLinkCandidates& Candidates,
+        const FHyperlinkStyle& linkStyle, FLineLinks& links) const;
+
+    void CreateUrlHyperlinks(const TSharedRef<FString>& LineText, int32 TextOffset, const FLinkCandidates& Candidates,
+        const FHyperlinkStyle& linkStyle, FLineLinks& links) const;
+
+    /** Text styles of a message with a certain verbosity style and log category */
+    struct FMessageStyle
+    {
+        FTextBlockStyle TextStyle;
+
+        /** Style of the repetition counter in collapsed mode */
+        FTextBlockStyle CountStyle;
+
+        FHyperlinkStyle LinkStyle;
+    };
+
+    /** Returns the styles for the message, they are created once per verbosity style and log category */
+    const FMessageStyle& GetStyle(const FLogMessage& Message) const;
+
+	/**
+	 * Creates the runs for the message text that starts at TextOffset in the line, with the links enabled in the display settings
+	 *
+	 * @param MessageStyle Styles of the message as returned by GetStyle
+	 * @return true if any link has been found
+	 */
+	bool CreateMessageTextRuns(uint64 Sequence, const FMessageStyle& MessageStyle, const TSharedRef<FString>& LineText, int32 TextOffset, TArray<TSharedRef<IRun>>& OutRuns) const;
+
+    /** Recompiles the log categories and forgets the cached styles */
+    void OnSettingChanged(FName PropertyName);
+
+	/** All log messages to show in the text box, shared with the other log windows */
+	TSharedRef<FLogMessageStore> Messages;
+
+	/** Index of the loaded blueprints to create blueprint hyperlinks, shared with the other log windows */
+	TSharedPtr<FBlueprintLinkIndex> BlueprintLinks;
+
+	/** Messages before this sequence number have been cleared from this view */
+	uint64 ClearedSequence;
+
+	/** Sequence number of the first message that has not been added to the text layout (or the rows in virtualized mode) yet */
+	uint64 LayoutEndSequence;
+
+	/** Count of the last message in the layout at the time it was added, to detect repetitions.
+	 *  Without collapsing, the number of its repetitions in the layout, which can lag behind if it has been repeated more often than fit into a frame. */
+	int32 LayoutLastMessageCount;
+
+	/** Sequence number of the first message whose filter result has not been computed since the filter has changed */
+	uint64 FilteredEndSequence;
+
+	/** Checks the messages from FilteredEndSequence on in the background, reset whenever the filter changes */
+	TUniquePtr<FLogFilterSearch> Search;
+
+	/** True if only the rows inside the window are added to the text layout */
+	bool bVirtualized;
+
+	/**
+	 * Virtualized or grouped mode: sequence number of the message shown in each row, the rows before FirstRow belong to evicted messages.
+	 * In grouped mode without virtualization every row is a line of the text layout and FirstRow is always 0.
+	 */
+	TArray<uint64> Rows;
+	int32 FirstRow;
+
+	/** Grouped mode: the distinct messages of this view, each one has a single row showing its newest message */
+	FLogMessageGroups Groups;
+
+	/** Grouped mode sorted by count: key of the group whose messages are listed below its row */
+	TOptional<uint64> ExpandedGroupKey;
+
+	/** Grouped mode sorted by count: sequence numbers of the messages of the expanded group, oldest first */
+	TArray<uint64> ExpandedMessages;
+
+	/** Grouped mode sorted by count: the rows in [ExpandedRowsStart, ExpandedRowsEnd) list the messages of the expanded group */
+	int32 ExpandedRowsStart;
+	int32 ExpandedRowsEnd;
+
+	/** Grouped mode sorted by count: no group whose newest message is older than this can be evicted */
+	uint64 OldestGroupSequence;
+
+	/** Grouped mode sorted by count: groups have changed since the rows were sorted, and FPlatformTime::Seconds() when they were */
+	bool bGroupSortPending;
+	double LastGroupSortTime;
+
+	/** Virtualized mode: the filter has changed since the rows were built */
+	bool bRowsDirty;
+
+	/** Virtualized mode: index into Rows of the first row in the text layout, and the maximum number of rows in the layout */
+	int32 WindowStart;
+	int32 WindowSize;
+
+	/** Handle to the registered OnMessagesEvicted delegate */
+	FDelegateHandle MessagesEvictedHandle;
+
+	/** Holds cached numbers of visible lines to avoid unnecessary re-filtering */
 	int32 CachedNumMessages;
 	
 	/** Flag indicating the messages count cache needs rebuilding */
@@ -437,11 +736,51 @@ protected:
 	/** Visible messages filter */
 	FLogFilter* Filter;
 
+	/** The marshaller itself, for the hyperlinks of its lines */
+	TWeakPtr<FOutputLogTextLayoutMarshaller> WeakThis;
+
+	/** Results of the filter for the messages of this view */
+	mutable FLogFilterResultCache FilterResults;
+
     FCustomTextLayout* TextLayout;
 
+    /** Finds the log category of a message */
+    FLogCategoryMatcher CategoryMatcher;
+
+    /** Which of the file paths found in the messages exist, checked in the background */
+    mutable FLogPathExistenceCache PathCache;
+
+    /** Link candidates of the messages whose lines have been created recently, by sequence number */
+    mutable TLruCache<uint64, FLinkCandidates> LinkCandidates;
+
+    /** A line of the text layout whose links have not been added yet */
+    struct FPendingLinkLine
+    {
+        /** Text of the line, identifies the line in the text layout */
+        TWeakPtr<FString> LineText;
+        uint64 Sequence = 0;
+
+        /** Start of the message text in the line, after the repetition counter */
+        int32 TextOffset = 0;
+    };
+
+    /** Lines whose links have not been added yet, without virtualization in the order they have been added to the text layout */
+    mutable TArray<FPendingLinkLine> PendingLinkLines;
+
+    /** Lines with file paths that are being checked in the background, by path. They are queued as pending lines if the path exists. */
+    mutable TMap<FString, TArray<FPendingLinkLine, TInlineAllocator<1>>> LinesWaitingForPaths;
+    mutable int32 NumLinesWaitingForPaths;
+
+    /** Styles by verbosity style name and log category index */
+    mutable TMap<TPair<FName, int32>, FMessageStyle> StyleCache;
+
+    /** Handle to the registered OnSettingChanged delegate */
+    FDelegateHandle SettingChangedHandle;
+
     FRegexPattern UrlPattern;
     FRegexPattern FilePathPattern;
 
 private:
-    static bool overlapping(const FTextRange& testRange, const TSet<FTextRange>& ranges);
+    /** Returns the index to insert a link with the range at, or INDEX_NONE if it overlaps or touches one of the links */
+    static int32 FindLinkIndex(const FLineLinks& links, const FTextRange& range);
 };
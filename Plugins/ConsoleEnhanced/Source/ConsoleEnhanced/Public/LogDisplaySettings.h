@@ -75,6 +75,22 @@ public:
         UPROPERTY(EditAnywhere, config, Category = "Output Log", AdvancedDisplay)
             float OutlineSize;
 
+        // The maximum number of lines kept in the log history. The oldest lines are discarded once this limit is reached.
+        UPROPERTY(EditAnywhere, config, Category = "Output Log", AdvancedDisplay, meta = (ClampMin = 1000, ConfigRestartRequired = true))
+            int32 MaxHistoryLines = 1000000;
+
+        // The maximum amount of memory (in MB) used by the log history. The oldest lines are discarded once this budget is exceeded.
+        UPROPERTY(EditAnywhere, config, Category = "Output Log", AdvancedDisplay, meta = (ClampMin = 16, ConfigRestartRequired = true))
+            int32 MaxHistoryMemoryMB = 512;
+
+        // The maximum number of lines added to each log window per frame. Lower values keep the editor responsive while a lot is logged, the remaining lines are shown over the next frames.
+        UPROPERTY(EditAnywhere, config, Category = "Output Log", AdvancedDisplay, meta = (ClampMin = 100))
+            int32 MaxLinesPerFrame = 2000;
+
+        // Only lays out the lines currently visible instead of the whole history, which keeps huge logs responsive. Text can only be selected within the visible lines. Applies to log windows opened afterwards.
+        UPROPERTY(EditAnywhere, config, Category = "Output Log", AdvancedDisplay)
+            bool bVirtualizedView = false;
+
         // The regex to determine if a log message is filtered out in "spam" mode. Caution! Only edit when you know what you are doing!
         UPROPERTY(EditAnywhere, config, Category = "Output Log", AdvancedDisplay, meta = (ConfigRestartRequired = true))
             FString AntiSpamRegex = FString(TEXT("(last play command: )|(No blueprints needed recompiling)|(PIE: )|(Creating play world package)|(LoadErrors: New page)|(Finished looking for orphan)|(Missing cached shader map)|(MapCheck: New page)|(Deleted Actor: )|(Deleted \\d* Actors)|(LogSavePackage: Save=)|(Finished SavePackage)|(LogFileHelpers: Saving map)|(Reallocating scene render targets)|(Native class hierarchy)|(MaterialEditorStats: )|(seconds spent updating \\d+ materials)|(Quitting Cascade)|(LogSavePackage: Moving)|(Creating AISystem)|(LogInit: )|(level for play took)|(LogEditorViewport: Clicking on Actor)|(New page: Lighting Build)"));
@@ -82,4 +98,15 @@ public:
         // Allows to define custom log categories by search string. The first matching category is applied to each line.
         UPROPERTY(EditAnywhere, config, Category = "Log Categories")
             TArray<FLogCategorySetting> LogCategories;
+
+        /** Broadcast after a setting has been changed in the editor */
+        DECLARE_EVENT_OneParam(ULogDisplaySettings, FSettingChangedEvent, FName /*PropertyName*/);
+        FSettingChangedEvent& OnSettingChanged() { return SettingChangedEvent; }
+
+#if WITH_EDITOR
+        virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+        FSettingChangedEvent SettingChangedEvent;
 };